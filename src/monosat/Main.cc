@@ -46,12 +46,16 @@
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <vector>
+#include <functional>
 #include "simp/SimpSolver.h"
 #include "pb/PbParser.h"
 #include "bv/BVParser.h"
 #include "amo/AMOTheory.h"
 #include "amo/AMOParser.h"
 #include "core/Optimize.h"
+#include "core/Portfolio.h"
 #include "core/Config.h"
 #include "pb/Config_pb.h"
 #include "monosat/Version.h"
@@ -69,6 +73,54 @@ void printStats(Solver& solver) {
 	printf("CPU time              : %g s\n", cpu_time);
 }
 
+//A solver, together with the parsers used to load the input formula into it.
+//In portfolio mode, each member of the portfolio loads its own copy of the input formula.
+struct Instance{
+	SimpSolver S;
+	Dimacs<StreamBuffer, SimpSolver> parser;
+	BVParser<char *, SimpSolver> bvParser;
+	SymbolParser<char*,SimpSolver> symbolParser;
+	GraphParser<char *, SimpSolver> graphParser;
+	FlowRouterParser<char *, SimpSolver> flowRouterParser;
+	PBParser<char *, SimpSolver> pbParser;
+	FSMParser<char*,SimpSolver> fsmParser;
+	AMOParser<char *, SimpSolver> amo;
+
+	Instance():graphParser(true,bvParser.theory),flowRouterParser(&graphParser),pbParser(S){
+		S.setPBSolver(new PB::PbSolver(S));
+		parser.addParser(&bvParser);
+		parser.addParser(&symbolParser);
+		parser.addParser(&graphParser);
+		parser.addParser(&flowRouterParser);
+		parser.addParser(&pbParser);
+		parser.addParser(&fsmParser);
+		parser.addParser(&amo);
+	}
+};
+
+//Preprocess a freshly loaded instance before solving. S.preprocess() is called _even_ if sat based preprocessing is disabled,
+//as some of the theory solvers depend on a preprocessing call being made!
+static void preprocessInstance(Instance & instance){
+	SimpSolver & S = instance.S;
+	S.preprocess();
+	if (opt_pre){
+		// Assumptions must be temporarily frozen to run variable elimination:
+		for (int i = 0; i < instance.parser.assumptions.size(); i++) {
+			Var v = var(instance.parser.assumptions[i]);
+
+			// If an assumption has been eliminated, remember it.
+			assert(!S.isEliminated(v));
+
+			if (!S.isFrozen(v)) {
+				// Freeze and store.
+				S.setFrozen(v, true);
+			}
+		}
+		S.eliminate(true);
+		//in principle, should unfreeze these lits after solving...
+	}
+}
+
 static SimpSolver* solver;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
@@ -185,6 +237,8 @@ void selectAlgorithms(){
 		reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED;
 	} else if (!strcasecmp(opt_reach_alg, "ramal-reps-batch2")) {
 		reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED2;
+	} else if (!strcasecmp(opt_reach_alg, "bfs-multi")) {
+		reachalg = ReachAlg::ALG_BFS_MULTI;
 	} else {
 		fprintf(stderr, "Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
 		exit(1);
@@ -206,6 +260,8 @@ void selectAlgorithms(){
 		distalg = DistAlg::ALG_RAMAL_REPS_BATCHED;
 	}else if (!strcasecmp(opt_dist_alg, "ramal-reps-batch2")) {
 		distalg = DistAlg::ALG_RAMAL_REPS_BATCHED2;
+	}else if (!strcasecmp(opt_dist_alg, "astar")) {
+		distalg = DistAlg::ALG_ASTAR;
 	}  else {
 		fprintf(stderr, "Error: unknown distance algorithm %s, aborting\n", ((string) opt_dist_alg).c_str());
 		exit(1);
@@ -505,10 +561,12 @@ int main(int argc, char** argv) {
 		BoolOption opt_witness("MAIN", "witness", "print solution", false);
 		StringOption opt_witness_file("MAIN", "witness-file", "write witness to file", "");
 		StringOption opt_theory_witness_file("MAIN", "theory-witness-file", "write witness for theories to file", "");
+		StringOption opt_stats_json("MAIN", "stats-json", "After solving, write solver statistics (including per-theory profiling counters, see -profile) as JSON to this file ('-' for stdout)", "");
 
 		BoolOption opb("PB", "opb", "Parse the input as pseudo-boolean constraints in .opb format", false);
 
 		BoolOption opt_ignore_solve_statements("MAIN","ignore-solves","Ignore any solve statements in the GNF",false);
+		StringOption opt_convert("MAIN","convert","Convert the input (text or binary GNF) to the given file and exit, without solving. Files named *.gnfb are written in binary GNF, and all others in text GNF.","");
 
 		IntOption opt_conflict_limit("MAIN","conflict-limit","",0,IntRange(0,INT32_MAX));
 
@@ -582,56 +640,83 @@ int main(int argc, char** argv) {
 #endif
 
 		const char *error;
-		SimpSolver S;
+		auto configureSolver = [&](SimpSolver & S){
+			S.min_decision_var = opt_min_decision_var - 1;
+			S.max_decision_var = opt_max_decision_var - 1;
+			S.min_priority_var = opt_min_priority_decision_var - 1;
+			S.max_priority_var = opt_max_priority_decision_var - 1;
+			if (!opt_pre)
+				S.eliminate(true);
+		};
+		//Load and preprocess a helper's own copy of the input formula (for portfolio solving or probing objective bounds).
+		//Returns false if the helper is no longer needed ('give_up' became true) by the time it has been loaded.
+		auto loadHelperInstance = [&](Instance & instance, const char * path, int member, const std::function<bool()> & give_up){
+			configureSolver(instance.S);
+			instance.S.verbosity=0;
+			instance.S.diversify(member);
+			StreamBuffer helper_strm(path, opt_mmap_input);
+			if (!helper_strm.isOpen())
+				throw std::runtime_error("Could not open input file");
+			if(opt_parser_immediate_mode) {
+				new Monosat::BVTheorySolver<int64_t>(&instance.S);
+			}
+			while(instance.S.okay() && instance.parser.parse(helper_strm, instance.S)){
+				if(*helper_strm==EOF){
+					break;
+				}
+				instance.parser.assumptions.clear();//solve statements are only processed by the primary solver
+			}
+			if(opt_ignore_solve_statements){
+				instance.parser.assumptions.clear();
+			}
+			if(give_up()){
+				return false;
+			}
+			preprocessInstance(instance);
+			return true;
+		};
+		Instance primary;
+		SimpSolver & S = primary.S;
 		solver = &S;
-		S.min_decision_var = opt_min_decision_var - 1;
-		S.max_decision_var = opt_max_decision_var - 1;
-		S.min_priority_var = opt_min_priority_decision_var - 1;
-		S.max_priority_var = opt_max_priority_decision_var - 1;
-
-		S.setPBSolver(new PB::PbSolver(S));
+		configureSolver(S);
 
 		if (opt_min_decision_var > 1 || opt_max_decision_var > 0) {
 			printf(
 					"Decision variables restricted to the range (%d..%d), which means a result of satisfiable may not be trustworthy.\n",
 					(uint) opt_min_decision_var, (uint) opt_max_decision_var);
 		}
-		if (!opt_pre)
-			S.eliminate(true);
 
-		gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-		if (in == NULL)
+		//stdin is read through zlib; input files are memory mapped, if they are uncompressed and -mmap-input is set
+		gzFile in = nullptr;
+		std::unique_ptr<StreamBuffer> input;
+		if (argc == 1) {
+			in = gzdopen(0, "rb");
+			if (in)
+				input.reset(new StreamBuffer(in));
+		} else {
+			input.reset(new StreamBuffer(argv[1], opt_mmap_input));
+		}
+		if (!input || !input->isOpen())
 			printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
 
+		if (strlen(opt_convert) > 0) {
+			bool binary = BinaryGNF::isBinaryFilename(opt_convert);
+			FILE * out = fopen(opt_convert, binary ? "wb" : "w");
+			if (!out)
+				printf("ERROR! Could not open file: %s\n", (const char*) opt_convert), exit(1);
+			int64_t n = BinaryGNF::convert(*input, out, binary);
+			fclose(out);
+			if (opt_verb > 0)
+				printf("Converted %" PRId64 " lines to %s GNF\n", n, binary ? "binary" : "text");
+			return 0;
+		}
+
 		if (opt_verb > 0) {
 			printf("============================[ Problem Statistics ]=============================\n");
 			printf("|                                                                             |\n");
 		}
 
-		Dimacs<StreamBuffer, SimpSolver> parser;
-		BVParser<char *, SimpSolver> bvParser;
-		parser.addParser(&bvParser);
-
-		SymbolParser<char*,SimpSolver> symbolParser;
-		parser.addParser(&symbolParser);
-
-		GraphParser<char *, SimpSolver> graphParser(true,bvParser.theory);
-		parser.addParser(&graphParser);
-
-		FlowRouterParser<char *, SimpSolver> flowRouterParser(&graphParser);
-		parser.addParser(&flowRouterParser);
-
-		PBParser<char *, SimpSolver> pbParser(S);
-		parser.addParser(&pbParser);
-
-		FSMParser<char*,SimpSolver> fsmParser;
-		parser.addParser(&fsmParser);
-
-		AMOParser<char *, SimpSolver> amo;
-		parser.addParser(&amo);
-
-
-
+		Dimacs<StreamBuffer, SimpSolver> & parser = primary.parser;
 
 		// Change to signal-handlers that will only notify the solver and allow it to terminate
 		// voluntarily:
@@ -641,7 +726,7 @@ int main(int argc, char** argv) {
 #endif
 		vec<Lit> assume;
 
-		StreamBuffer strm(in);
+		StreamBuffer & strm = *input;
 		if(opt_parser_immediate_mode) {
 			Monosat::BVTheorySolver<int64_t> *bv = new Monosat::BVTheorySolver<int64_t>(&S);//temporary!
 		}
@@ -662,7 +747,9 @@ int main(int argc, char** argv) {
 				parser.assumptions.clear();
 			}
 		}
-		gzclose(in);
+		input.reset();
+		if (in)
+			gzclose(in);
 		if(opt_ignore_solve_statements){
 			parser.assumptions.clear();
 		}
@@ -677,28 +764,11 @@ int main(int argc, char** argv) {
 		if (opt_verb > 0) {
 			printf("Parsing time = %f\n", parsing_time);
 		}
-		S.preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
-
-		if (opt_pre){
-			if (opt_verb > 0){
-				printf("simplify:\n");
-				fflush(stdout);
-			}
-			// Assumptions must be temporarily frozen to run variable elimination:
-			for (int i = 0; i < parser.assumptions.size(); i++) {
-				Var v = var(parser.assumptions[i]);
-
-				// If an assumption has been eliminated, remember it.
-				assert(!S.isEliminated(v));
-
-				if (!S.isFrozen(v)) {
-					// Freeze and store.
-					S.setFrozen(v, true);
-				}
-			}
-			S.eliminate(true);
-			//in principle, should unfreeze these lits after solving...
+		if (opt_pre && opt_verb > 0){
+			printf("simplify:\n");
+			fflush(stdout);
 		}
+		preprocessInstance(primary);
 		fflush(stdout);
 		//exit(0);
 		double after_preprocessing =  rtime(0);
@@ -713,7 +783,67 @@ int main(int argc, char** argv) {
 
 
 
-		lbool ret = optimize_and_solve(S,parser.assumptions,parser.objectives,false,found_optimal);
+		int n_portfolio = opt_portfolio;
+		if(n_portfolio>1 && argc == 1){
+			fprintf(stderr,"Warning: portfolio solving requires the input to be read from a file, not stdin; solving with a single solver.\n");
+			n_portfolio=1;
+		}else if (n_portfolio>1 && parser.objectives.size()){
+			fprintf(stderr,"Warning: portfolio solving does not support optimization objectives; solving with a single solver.\n");
+			n_portfolio=1;
+		}
+		lbool ret = l_Undef;
+		//the instance whose solution is reported (in portfolio mode, the first member to finish)
+		Instance * result = &primary;
+		std::vector<std::unique_ptr<Instance>> helpers(n_portfolio);
+		if(n_portfolio<=1 && opt_optimization_probes>0 && parser.objectives.size() && argc>1){
+			//objective bounds are probed on separate copies of the input formula
+			int n_probes = opt_optimization_probes;
+			std::vector<std::unique_ptr<Instance>> probes(n_probes);
+			runPortfolio(n_probes,[&](int p){
+				probes[p].reset(new Instance());
+				loadHelperInstance(*probes[p],argv[1],p+1,[](){return false;});
+			});
+			std::vector<SimpSolver*> copies;
+			for(auto & probe:probes){
+				copies.push_back(&probe->S);
+			}
+			BoundProber prober(S,copies);
+			ret = optimize_and_solve(S,parser.assumptions,parser.objectives,false,found_optimal,&prober);
+		}else if(n_portfolio<=1){
+			ret = optimize_and_solve(S,parser.assumptions,parser.objectives,false,found_optimal);
+		}else{
+			if (opt_verb > 0){
+				printf("Solving with a portfolio of %d solvers\n",n_portfolio);
+			}
+			ClauseExchange exchange(n_portfolio, opt_portfolio_share_size);
+			std::vector<lbool> results(n_portfolio,l_Undef);
+			runPortfolio(n_portfolio,[&](int member){
+				Instance * instance = &primary;
+				if(member>0){
+					helpers[member].reset(new Instance());
+					instance = helpers[member].get();
+					if(!loadHelperInstance(*instance,argv[1],member,[&](){return exchange.isFinished();})){
+						return;
+					}
+				}
+				instance->S.setClauseExchange(&exchange,member);
+				lbool r = instance->S.solveLimited(instance->parser.assumptions,false,false);
+				instance->S.setClauseExchange(nullptr,-1);
+				if(r!=l_Undef && exchange.finish(member)){
+					results[member]=r;
+				}
+			});
+			int winner = exchange.getWinner();
+			if(winner>=0){
+				ret = results[winner];
+				if(winner>0){
+					result = helpers[winner].get();
+				}
+				if (opt_verb > 0){
+					printf("Portfolio solver %d finished first\n",winner);
+				}
+			}
+		}
 		double solving_time = rtime(0) - after_preprocessing;
 		if (opt_verb > 0) {
 			printf("Solving time = %f\n", solving_time);
@@ -728,12 +858,12 @@ int main(int argc, char** argv) {
 				FILE * f = fopen(opt_witness_file, "w");
 				if (f) {
 					fprintf(f, "v ");
-					for (int v = 0; v < S.nVars(); v++) {
-						if(parser.hasMappedVar(v)) {
-							if (S.model[v] == l_True) {
-								fprintf(f, "%d ", (parser.unmap(v) + 1));
-							} else if (S.model[v] == l_False) {
-								fprintf(f, "%d ", -(parser.unmap(v) + 1));
+					for (int v = 0; v < result->S.nVars(); v++) {
+						if(result->parser.hasMappedVar(v)) {
+							if (result->S.model[v] == l_True) {
+								fprintf(f, "%d ", (result->parser.unmap(v) + 1));
+							} else if (result->S.model[v] == l_False) {
+								fprintf(f, "%d ", -(result->parser.unmap(v) + 1));
 							}
 						}
 					}
@@ -747,14 +877,14 @@ int main(int argc, char** argv) {
 			if (strlen(opt_theory_witness_file) > 0) {
 				std::cout<<"Writing witness to file " << (const char*) opt_theory_witness_file <<"\n";
 				std::ofstream theory_out(opt_theory_witness_file, ios::out);
-				S.writeTheoryWitness(theory_out);
+				result->S.writeTheoryWitness(theory_out);
 				/*for (auto p : symbols) {
 					Var v = p.first;
 					string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (result->S.model[v] == l_True) {
 						theory_out<< "var "<<  s <<"\n";
 
-					} else if (S.model[v] == l_False) {
+					} else if (result->S.model[v] == l_False) {
 						//theory_out<< "-"<<  s <<"\n";
 					} else {
 						//this is unassigned
@@ -766,18 +896,18 @@ int main(int argc, char** argv) {
 			if (opt_witness) {
 
 				printf("v ");
-				for (int v = 0; v < S.nVars() && v<S.model.size(); v++) {
-					if(parser.hasMappedVar(v)) {
-						Var uv = parser.unmap(v);
+				for (int v = 0; v < result->S.nVars() && v<result->S.model.size(); v++) {
+					if(result->parser.hasMappedVar(v)) {
+						Var uv = result->parser.unmap(v);
 						assert (uv >= 0);
 
 						if (uv < 0 || uv > 10000) {
 							int a = 1;
-							int b = parser.unmap(v);
+							int b = result->parser.unmap(v);
 						}
-						if (S.model[v] == l_True) {
+						if (result->S.model[v] == l_True) {
 							printf("%d ", (uv + 1));
-						} else if (S.model[v] == l_False) {
+						} else if (result->S.model[v] == l_False) {
 							printf("%d ", -(uv + 1));
 						}
 
@@ -792,10 +922,10 @@ int main(int argc, char** argv) {
 				for (auto p : symbols) {
 					Var v = p.first;
 					string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (result->S.model[v] == l_True) {
 						fprintf(sfile, ":- not %s.\n", s.c_str());
 						//cout<<":- not "<< s<<".\n";
-					} else if (S.model[v] == l_False) {
+					} else if (result->S.model[v] == l_False) {
 						fprintf(sfile, ":- %s.\n", s.c_str());
 						//cout<<":- "<<s<<".\n";
 					} else {
@@ -812,10 +942,10 @@ int main(int argc, char** argv) {
 				for (auto p : symbols) {
 					Var v = p.first;
 					std::string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (result->S.model[v] == l_True) {
 						printf("%s ", s.c_str());
 						//cout<<":- not "<< s<<".\n";
-					} else if (S.model[v] == l_False) {
+					} else if (result->S.model[v] == l_False) {
 						printf("-%s ", s.c_str());
 						//cout<<":- "<<s<<".\n";
 					}
@@ -824,8 +954,8 @@ int main(int argc, char** argv) {
 			}
 			 */
 			if (opt_verb > 2) {
-				for (int i = 0; i < S.theories.size(); i++)
-					S.theories[i]->printSolution();
+				for (int i = 0; i < result->S.theories.size(); i++)
+					result->S.theories[i]->printSolution();
 			}
 			if (!opt_csv)
 				printf("s SATISFIABLE\n");
@@ -835,9 +965,24 @@ int main(int argc, char** argv) {
 			printf("UNKNOWN\n");
 		}
 		if (opt_verb > 1) {
-			printStats(S);
+			printStats(result->S);
 
 		}
+		if (strlen(opt_stats_json) > 0) {
+			if (strcmp(opt_stats_json, "-") == 0) {
+				result->S.writeStatsJSON(std::cout);
+				std::cout << "\n";
+				std::cout.flush();
+			} else {
+				std::ofstream stats_out(opt_stats_json, ios::out);
+				if (stats_out) {
+					result->S.writeStatsJSON(stats_out);
+					stats_out << "\n";
+				} else {
+					fprintf(stderr, "Failed to write stats to file!\n");
+				}
+			}
+		}
 		fflush(stdout);
 
 		return (ret == l_True ? 10 : ret == l_False ? 20 : 0);
@@ -24,18 +24,85 @@
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Vec.h"
+#include "monosat/mtl/Sort.h"
+#include "monosat/api/GNFRecorder.h"
+#include "monosat/core/Config.h"
+#include <algorithm>
+#include <cstdint>
 #include <list>
 #include <stdio.h>
+#include <unordered_map>
+#include <vector>
 
 namespace Monosat {
 
 //Helper methods for expressing combinatorial logic in CNF.
-//Does not perform any kind of circuit rewriting, simplification, or memoization.
+//Gates are simplified when their inputs are constant (or equal, or complementary), and,
+//unless -circuit-hash is disabled, gates that do not specify their own output literal are structurally hashed:
+//building the same gate over the same inputs a second time returns the first gate's output instead of
+//introducing a new variable and new clauses.
 template<class Solver>
 class Circuit {
     Solver &S;
     Lit lit_True = lit_Undef;
 
+    struct LitsHash {
+        size_t operator()(const std::vector<int> &lits) const {
+            uint64_t h = 14695981039346656037ULL;
+            for (int l:lits) {
+                h = (h ^ (uint64_t) l) * 1099511628211ULL;
+            }
+            return h;
+        }
+    };
+    //Structural hash tables, mapping the normalized inputs of each gate to its output.
+    //Or gates are stored as And gates (Or(a,b) == ~And(~a,~b)), and Xor gates are stored over
+    //unsigned inputs, with the output negated according to the signs of the inputs.
+    std::unordered_map<uint64_t, Lit> and_gates;
+    std::unordered_map<uint64_t, Lit> xor_gates;
+    std::unordered_map<std::vector<int>, Lit, LitsHash> nary_and_gates;
+    std::vector<int> key_tmp;
+
+    static uint64_t gateKey(Lit a, Lit b) {
+        assert(toInt(a) <= toInt(b));
+        return ((uint64_t) toInt(a) << 32) | (uint32_t) toInt(b);
+    }
+
+    //Theory solvers that build circuits don't expose preprocessing, so only check for eliminated variables where possible
+    template<typename T>
+    static auto isEliminated(T &solver, Var v, int) -> decltype(solver.isEliminated(v)) {
+        return solver.isEliminated(v);
+    }
+
+    template<typename T>
+    static bool isEliminated(T &solver, Var v, long) {
+        return false;
+    }
+
+    //Returns the output of a previously built gate, or lit_Undef
+    template<typename Table, typename Key>
+    Lit lookupGate(Table &table, const Key &key) {
+        if (!opt_circuit_hash)
+            return lit_Undef;
+        auto it = table.find(key);
+        if (it != table.end()) {
+            //gate outputs are not frozen, so they may have been removed by preprocessing since they were built
+            if (!isEliminated(S, var(it->second), 0)) {
+                stats_gate_hits++;
+                return it->second;
+            }
+            table.erase(it);
+        }
+        stats_gate_misses++;
+        return lit_Undef;
+    }
+
+    template<typename Table, typename Key>
+    void rememberGate(Table &table, const Key &key, Lit out) {
+        if (opt_circuit_hash)
+            table[key] = out;
+    }
+
     bool isConst(Lit l) {
         return isConstTrue(l) || isConstFalse(l);
     }
@@ -50,9 +117,10 @@ class Circuit {
 
     vec <Lit> tmp;
     vec <Lit> tmp2;
+    vec <Lit> tmp3;
     vec <Lit> clause;
     vec <Lit> store;
-    FILE *outfile = nullptr;
+    GNFRecorder *outfile = nullptr;
 
     inline int dimacs(Solver &S, Lit internalLit) {
         Lit l = S.unmap(internalLit);
@@ -61,24 +129,21 @@ class Circuit {
 
     bool _addClause(Lit a) {
         if (outfile) {
-            fprintf(outfile, "%d 0\n ", dimacs(S, a));
-            fflush(outfile);
+            outfile->printf("%d 0\n ", dimacs(S, a));
         }
         return S.addClause(a);
     }
 
     bool _addClause(Lit a, Lit b) {
         if (outfile) {
-            fprintf(outfile, "%d %d 0\n ", dimacs(S, a), dimacs(S, b));
-            fflush(outfile);
+            outfile->printf("%d %d 0\n ", dimacs(S, a), dimacs(S, b));
         }
         return S.addClause(a, b);
     }
 
     bool _addClause(Lit a, Lit b, Lit c) {
         if (outfile) {
-            fprintf(outfile, "%d %d %d 0\n ", dimacs(S, a), dimacs(S, b), dimacs(S, c));
-            fflush(outfile);
+            outfile->printf("%d %d %d 0\n ", dimacs(S, a), dimacs(S, b), dimacs(S, c));
         }
         return S.addClause(a, b, c);
     }
@@ -86,10 +151,9 @@ class Circuit {
     bool _addClause(vec <Lit> &clause) {
         if (outfile) {
             for (Lit l:clause) {
-                fprintf(outfile, "%d ", dimacs(S, l));
+                outfile->printf("%d ", dimacs(S, l));
             }
-            fprintf(outfile, "0\n");
-            fflush(outfile);
+            outfile->printf("0\n");
         }
         return S.addClause(clause);
     }
@@ -129,11 +193,15 @@ class Circuit {
     }
 
 public:
+    //Number of gates that were answered from the structural hash tables, and number of gates that had to be built
+    uint64_t stats_gate_hits = 0;
+    uint64_t stats_gate_misses = 0;
+
     /**
-     * Specify a file to write constructed clauses to (in GNF format)
+     * Specify a recorder to write constructed clauses to (in GNF format)
      * @param file
      */
-    void setOutputFile(FILE *file) {
+    void setOutputFile(GNFRecorder *file) {
         this->outfile = file;
     }
 
@@ -163,6 +231,9 @@ public:
     }
 
     Lit And_(Lit a, Lit b, Lit out) {
+        if (out == lit_Undef) {
+            return And(a, b);
+        }
         //special case these
         if (isConst(a) || isConst(b)) {
             if (isConstTrue(a) && isConstTrue(b)) {
@@ -250,8 +321,42 @@ public:
             }
             return tmp[0];
         }
+        bool hashed = false;
         if (out == lit_Undef) {
+            //normalize the inputs, dropping duplicates and checking for complementary pairs
+            sort(tmp);
+            int j = 1;
+            for (int i = 1; i < tmp.size(); i++) {
+                if (tmp[i] == tmp[j - 1]) {
+                    continue;
+                } else if (tmp[i] == ~tmp[j - 1]) {
+                    tmp.clear();
+                    return getFalse();
+                }
+                tmp[j++] = tmp[i];
+            }
+            tmp.shrink(tmp.size() - j);
+            if (tmp.size() == 1) {
+                Lit a = tmp[0];
+                tmp.clear();
+                return a;
+            } else if (tmp.size() == 2) {
+                Lit a = tmp[0];
+                Lit b = tmp[1];
+                tmp.clear();
+                return And(a, b);
+            }
+            key_tmp.clear();
+            for (Lit l:tmp) {
+                key_tmp.push_back(toInt(l));
+            }
+            out = lookupGate(nary_and_gates, key_tmp);
+            if (out != lit_Undef) {
+                tmp.clear();
+                return out;
+            }
             out = mkLit(S.newVar());
+            hashed = true;
         }
         for (Lit l:tmp) {
             _addClause(l, ~out);
@@ -262,6 +367,9 @@ public:
         tmp.push(out);
         _addClause(tmp);
         tmp.clear();
+        if (hashed) {
+            rememberGate(nary_and_gates, key_tmp, out);
+        }
         return out;
     }
 
@@ -330,11 +438,19 @@ public:
                 return b;
             }
         }
-
-        Lit out = mkLit(S.newVar());
+        if (toInt(b) < toInt(a)) {
+            std::swap(a, b);
+        }
+        uint64_t key = gateKey(a, b);
+        Lit out = lookupGate(and_gates, key);
+        if (out != lit_Undef) {
+            return out;
+        }
+        out = mkLit(S.newVar());
         _addClause(a, ~out);
         _addClause(b, ~out);
         _addClause(~a, ~b, out);
+        rememberGate(and_gates, key, out);
         return out;
     }
 
@@ -380,16 +496,14 @@ public:
         } else if (isConstFalse(b)) {
             return a;
         }
-
-        Lit out = mkLit(S.newVar());
-        _addClause(~a, out);
-        _addClause(~b, out);
-        _addClause(a, b, ~out);
-        return out;
+        //shares its gates (and clauses, up to the sign of the output) with And
+        return ~And(~a, ~b);
     }
 
     Lit Or_(Lit a, Lit b, Lit out) {
-
+        if (out == lit_Undef) {
+            return Or(a, b);
+        }
         //special case these
         if (isConst(a) || isConst(b)) {
 
@@ -437,6 +551,13 @@ public:
     }
 
     Lit Or_(const vec <Lit> &vals, Lit out) {
+        if (out == lit_Undef) {
+            tmp3.clear();
+            for (Lit l:vals) {
+                tmp3.push(~l);
+            }
+            return ~And_(tmp3, lit_Undef);
+        }
         tmp.clear();
         for (Lit l:vals) {
             if (isConstFalse(l)) {
@@ -630,16 +751,36 @@ public:
                 return a;
             }
         }
-        //return Or(And(a, ~b), And(~a,b));
-        Lit out = mkLit(S.newVar());
-        _addClause(a, b, ~out);
-        _addClause(~a, b, out);
-        _addClause(a, ~b, out);
-        _addClause(~a, ~b, ~out);
-        return out;
+        if (a == b) {
+            return getFalse();
+        } else if (a == ~b) {
+            return getTrue();
+        }
+        //Xor(~a,b) == ~Xor(a,b), so only build gates over unsigned inputs
+        bool flip = sign(a) != sign(b);
+        a = mkLit(var(a));
+        b = mkLit(var(b));
+        if (toInt(b) < toInt(a)) {
+            std::swap(a, b);
+        }
+        uint64_t key = gateKey(a, b);
+        Lit out = lookupGate(xor_gates, key);
+        if (out == lit_Undef) {
+            //return Or(And(a, ~b), And(~a,b));
+            out = mkLit(S.newVar());
+            _addClause(a, b, ~out);
+            _addClause(~a, b, out);
+            _addClause(a, ~b, out);
+            _addClause(~a, ~b, ~out);
+            rememberGate(xor_gates, key, out);
+        }
+        return flip ? ~out : out;
     }
 
     Lit Xor_(Lit a, Lit b, Lit out) {
+        if (out == lit_Undef) {
+            return Xor(a, b);
+        }
         if (isConst(a) || isConst(b)) {
             if (isConstTrue(a)) {
                 if (out != lit_Undef) {
@@ -664,9 +805,6 @@ public:
             }
         }
         //return Or(And(a, ~b), And(~a,b));
-        if (out != lit_Undef) {
-            out = mkLit(S.newVar());
-        }
         _addClause(a, b, ~out);
         _addClause(~a, b, out);
         _addClause(a, ~b, out);
@@ -707,7 +845,10 @@ public:
     }
 
     Lit Xnor_(Lit a, Lit b, Lit out) {
-        return ~Xnor(a, b, out);
+        if (out == lit_Undef) {
+            return Xnor(a, b);
+        }
+        return ~Xor_(a, b, ~out);
     }
 
     Lit Xnor(const std::list<Lit> &vals) {
@@ -738,12 +879,34 @@ public:
 
 
     Lit Ite(Lit cond, Lit thn, Lit els) {
+        if (sign(cond)) {
+            cond = ~cond;
+            std::swap(thn, els);
+        }
+        if (isConstTrue(cond) || thn == els) {
+            return thn;
+        } else if (isConstFalse(cond)) {
+            return els;
+        } else if (thn == ~els) {
+            return Xnor(cond, thn);
+        } else if (thn == cond || isConstTrue(thn)) {
+            return Or(cond, els);
+        } else if (thn == ~cond || isConstFalse(thn)) {
+            return And(~cond, els);
+        } else if (els == ~cond || isConstTrue(els)) {
+            return Or(~cond, thn);
+        } else if (els == cond || isConstFalse(els)) {
+            return And(cond, thn);
+        }
         Lit l = ~And(cond, ~thn);
         Lit r = ~And(~cond, ~els);
         return And(l, r);
     }
 
     Lit Ite_(Lit cond, Lit thn, Lit els, Lit out) {
+        if (out == lit_Undef) {
+            return Ite(cond, thn, els);
+        }
         Lit l = ~And(cond, ~thn);
         Lit r = ~And(~cond, ~els);
         return And_(l, r, out);
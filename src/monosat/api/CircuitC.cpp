@@ -59,10 +59,6 @@ inline int dimacs_(Monosat::SimpSolver * S, Lit internalLit_) {
 }
 
 
-vec<Lit> tmp_lits_a;
-vec<Lit> tmp_lits_b;
-vec<Lit> tmp_lits_c;
-
 void toVec(Monosat::SimpSolver *S,int * lits, int n_lits, vec<Lit> & store){
     assert(lits);
     assert(n_lits>=0);
@@ -116,16 +112,16 @@ int Ands_(Monosat::SimpSolver *S, int *lits, int n_lits, int lit_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.And_(tmp_lits_a,internalLit_(S,lit_out)));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.And_(d->tmp_lits_a,internalLit_(S,lit_out)));
 }
 
 int Ands(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.And(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.And(d->tmp_lits_a));
 }
 
 int And(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -146,8 +142,8 @@ int Ors_(Monosat::SimpSolver *S, int *lits, int n_lits, int lit_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Or_(tmp_lits_a,internalLit_(S,lit_out)));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Or_(d->tmp_lits_a,internalLit_(S,lit_out)));
 }
 
 //If this gate is true, then all of vals must be true.
@@ -156,8 +152,8 @@ int ImpliesAnd_(Monosat::SimpSolver *S, int *lits, int n_lits, int lit_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.ImpliesAnd(tmp_lits_a,internalLit_(S,lit_out)));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.ImpliesAnd(d->tmp_lits_a,internalLit_(S,lit_out)));
 }
 
 //If this gate is true, then at least one of vals must be true.
@@ -166,16 +162,16 @@ int ImpliesOr(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.ImpliesOr(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.ImpliesOr(d->tmp_lits_a));
 }
 
 int ImpliesOr_(Monosat::SimpSolver *S, int *lits, int n_lits, int lit_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.ImpliesOr(tmp_lits_a,internalLit_(S,lit_out)));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.ImpliesOr(d->tmp_lits_a,internalLit_(S,lit_out)));
 }
 
 //This is an OR condition that holds only if implies is true
@@ -183,8 +179,8 @@ void AssertImpliesOr_(Monosat::SimpSolver *S, int implies, int *lits, int n_lits
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertImpliesOr_(internalLit_(S,implies), tmp_lits_a,internalLit_(S,lit_out));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertImpliesOr_(internalLit_(S,implies), d->tmp_lits_a,internalLit_(S,lit_out));
 }
 
 void AssertImpliesAnd_(Monosat::SimpSolver *S, int implies, int *lits, int n_lits, int lit_out) {
@@ -192,15 +188,15 @@ void AssertImpliesAnd_(Monosat::SimpSolver *S, int implies, int *lits, int n_lit
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
 
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertImpliesAnd_(internalLit_(S,implies), tmp_lits_a,internalLit_(S,lit_out));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertImpliesAnd_(internalLit_(S,implies), d->tmp_lits_a,internalLit_(S,lit_out));
 }
 void AssertImpliesOr(Monosat::SimpSolver *S, int implies, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertImpliesOr_(internalLit_(S,implies), tmp_lits_a,lit_Undef);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertImpliesOr_(internalLit_(S,implies), d->tmp_lits_a,lit_Undef);
 }
 
 void AssertImpliesAnd(Monosat::SimpSolver *S, int implies, int *lits, int n_lits) {
@@ -208,16 +204,16 @@ void AssertImpliesAnd(Monosat::SimpSolver *S, int implies, int *lits, int n_lits
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
 
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertImpliesAnd_(internalLit_(S,implies), tmp_lits_a,lit_Undef);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertImpliesAnd_(internalLit_(S,implies), d->tmp_lits_a,lit_Undef);
 }
 
 int Ors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Or(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Or(d->tmp_lits_a));
 }
 
 int Or(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -231,8 +227,8 @@ int Nors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Nor(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Nor(d->tmp_lits_a));
 }
 
 int Nor(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -246,8 +242,8 @@ int Nands(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Nand(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Nand(d->tmp_lits_a));
 }
 
 int Nand(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -261,8 +257,8 @@ int Xors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Xor(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Xor(d->tmp_lits_a));
 }
 
 int Xor(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -277,8 +273,8 @@ int Xnors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    return externalLit_(S,circuit.Xnor(tmp_lits_a));
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    return externalLit_(S,circuit.Xnor(d->tmp_lits_a));
 }
 
 int Xnor(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -320,15 +316,15 @@ int Add(Monosat::SimpSolver *S, int *lits_a, int *lits_b, int n_lits, int *lits_
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    tmp_lits_c.clear();
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    d->tmp_lits_c.clear();
     Lit carry=lit_Undef;
-    circuit.Add(tmp_lits_a,tmp_lits_b,tmp_lits_c,carry);
+    circuit.Add(d->tmp_lits_a,d->tmp_lits_b,d->tmp_lits_c,carry);
     assert(lits_out);
-    assert(tmp_lits_c.size()==n_lits);
-    for(int i = 0;i<tmp_lits_c.size();i++){
-        lits_out[i]=externalLit_(S,tmp_lits_c[i]);
+    assert(d->tmp_lits_c.size()==n_lits);
+    for(int i = 0;i<d->tmp_lits_c.size();i++){
+        lits_out[i]=externalLit_(S,d->tmp_lits_c[i]);
     }
     return externalLit_(S,carry);
 }
@@ -337,12 +333,12 @@ int Add_(Monosat::SimpSolver *S, int *lits_a, int *lits_b, int n_lits, int *lits
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
     assert(lits_out);
-    toVec(S,lits_out,n_lits,tmp_lits_c);
+    toVec(S,lits_out,n_lits,d->tmp_lits_c);
     Lit carry=lit_Undef;
-    circuit.Add_(tmp_lits_a,tmp_lits_b,tmp_lits_c,carry);
+    circuit.Add_(d->tmp_lits_a,d->tmp_lits_b,d->tmp_lits_c,carry);
     return externalLit_(S,carry);
 }
 
@@ -350,15 +346,15 @@ int Subtract(Monosat::SimpSolver *S, int *lits_a, int *lits_b, int n_lits, int *
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    tmp_lits_c.clear();
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    d->tmp_lits_c.clear();
     Lit carry=lit_Undef;
-    circuit.Subtract(tmp_lits_a,tmp_lits_b,tmp_lits_c,carry);
+    circuit.Subtract(d->tmp_lits_a,d->tmp_lits_b,d->tmp_lits_c,carry);
     assert(lits_out);
-    assert(tmp_lits_c.size()==n_lits);
-    for(int i = 0;i<tmp_lits_c.size();i++){
-        lits_out[i]=externalLit_(S,tmp_lits_c[i]);
+    assert(d->tmp_lits_c.size()==n_lits);
+    for(int i = 0;i<d->tmp_lits_c.size();i++){
+        lits_out[i]=externalLit_(S,d->tmp_lits_c[i]);
     }
     return externalLit_(S,carry);
 }
@@ -367,13 +363,13 @@ int Subtract_(Monosat::SimpSolver *S, int *lits_a, int *lits_b, int n_lits, int
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
     assert(lits_out);
 
-    toVec(S,lits_out,n_lits,tmp_lits_c);
+    toVec(S,lits_out,n_lits,d->tmp_lits_c);
     Lit carry=lit_Undef;
-    circuit.Subtract_(tmp_lits_a,tmp_lits_b,tmp_lits_c,carry);
+    circuit.Subtract_(d->tmp_lits_a,d->tmp_lits_b,d->tmp_lits_c,carry);
     return externalLit_(S,carry);
 }
 
@@ -383,13 +379,13 @@ void Negate(Monosat::SimpSolver *S, int *lits, int n_lits, int *lits_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    tmp_lits_b.clear();
-    circuit.Negate(tmp_lits_a,tmp_lits_b);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    d->tmp_lits_b.clear();
+    circuit.Negate(d->tmp_lits_a,d->tmp_lits_b);
     assert(lits_out);
-    assert(tmp_lits_b.size()==n_lits);
-    for(int i = 0;i<tmp_lits_b.size();i++){
-        lits_out[i]=externalLit_(S,tmp_lits_b[i]);
+    assert(d->tmp_lits_b.size()==n_lits);
+    for(int i = 0;i<d->tmp_lits_b.size();i++){
+        lits_out[i]=externalLit_(S,d->tmp_lits_b[i]);
     }
 }
 
@@ -398,10 +394,10 @@ void Negate_(Monosat::SimpSolver *S, int *lits, int n_lits, int *lits_out) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
     assert(lits_out);
-    toVec(S,lits_out,n_lits,tmp_lits_b);
-    circuit.Negate_(tmp_lits_a,tmp_lits_b);
+    toVec(S,lits_out,n_lits,d->tmp_lits_b);
+    circuit.Negate_(d->tmp_lits_a,d->tmp_lits_b);
 }
 
 void Assert(Monosat::SimpSolver *S, int lit) {
@@ -422,8 +418,8 @@ void AssertOrs(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertOr(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertOr(d->tmp_lits_a);
 }
 
 void AssertOr(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -437,8 +433,8 @@ void AssertNands(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertNand(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertNand(d->tmp_lits_a);
 }
 
 void AssertNand(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -452,8 +448,8 @@ void AssertAnds(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertAnd(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertAnd(d->tmp_lits_a);
 }
 
 void AssertAnd(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -467,8 +463,8 @@ void AssertNors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertNor(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertNor(d->tmp_lits_a);
 }
 
 void AssertNor(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -489,16 +485,16 @@ void AssertXors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertXor(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertXor(d->tmp_lits_a);
 }
 
 void AssertXnors(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertXnor(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertXnor(d->tmp_lits_a);
 }
 
 void AssertXnor(Monosat::SimpSolver *S, int lit_a, int lit_b) {
@@ -526,8 +522,8 @@ void AssertAllSame(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    //circuit.AssertEqual(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    //circuit.AssertEqual(d->tmp_lits_a);
     throw std::runtime_error("Not yet implemetned");
 }
 
@@ -536,55 +532,55 @@ int Equals(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
     throw std::runtime_error("Not yet implemetned");
-   // return externalLit_(S,circuit.Equal(tmp_lits_a,tmp_lits_b));
+   // return externalLit_(S,circuit.Equal(d->tmp_lits_a,d->tmp_lits_b));
 }
 
 int LEQ(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    return externalLit_(S,circuit.LEQ(tmp_lits_a,tmp_lits_b));
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    return externalLit_(S,circuit.LEQ(d->tmp_lits_a,d->tmp_lits_b));
 }
 
 int LT(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    return externalLit_(S,circuit.LT(tmp_lits_a,tmp_lits_b));
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    return externalLit_(S,circuit.LT(d->tmp_lits_a,d->tmp_lits_b));
 }
 
 void AssertEquals(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    circuit.AssertEqual(tmp_lits_a,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    circuit.AssertEqual(d->tmp_lits_a,d->tmp_lits_b);
 }
 
 void AssertLEQ(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    circuit.AssertLEQ(tmp_lits_a,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    circuit.AssertLEQ(d->tmp_lits_a,d->tmp_lits_b);
 }
 
 void AssertLT(Monosat::SimpSolver *S, int *lits_a,  int *lits_b, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits_a,n_lits,tmp_lits_a);
-    toVec(S,lits_b,n_lits,tmp_lits_b);
-    circuit.AssertLT(tmp_lits_a,tmp_lits_b);
+    toVec(S,lits_a,n_lits,d->tmp_lits_a);
+    toVec(S,lits_b,n_lits,d->tmp_lits_b);
+    circuit.AssertLT(d->tmp_lits_a,d->tmp_lits_b);
 }
 
 //uses n^2 binary clauses to create a simple at-most-one constraint.
@@ -593,8 +589,8 @@ void AssertAMO(Monosat::SimpSolver *S, int *lits, int n_lits){
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertAMO(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertAMO(d->tmp_lits_a);
 }
 
 //uses n^2 binary clauses to create a simple exactly-one-constraint.
@@ -603,6 +599,18 @@ void AssertExactlyOne(Monosat::SimpSolver *S, int *lits, int n_lits) {
     MonosatData *d = (MonosatData *) S->_external_data;
     assert(d);
     Monosat::Circuit<Monosat::SimpSolver> &circuit = d->circuit;
-    toVec(S,lits,n_lits,tmp_lits_a);
-    circuit.AssertExactlyOne(tmp_lits_a);
+    toVec(S,lits,n_lits,d->tmp_lits_a);
+    circuit.AssertExactlyOne(d->tmp_lits_a);
+}
+
+uint64_t nCircuitGateHits(Monosat::SimpSolver *S) {
+    MonosatData *d = (MonosatData *) S->_external_data;
+    assert(d);
+    return d->circuit.stats_gate_hits;
+}
+
+uint64_t nCircuitGateMisses(Monosat::SimpSolver *S) {
+    MonosatData *d = (MonosatData *) S->_external_data;
+    assert(d);
+    return d->circuit.stats_gate_misses;
 }
@@ -154,6 +154,11 @@ void AssertAMO(SolverPtr S,int * lits, int n_lits) ;
 //if you have more than 20 or so literals, strongly consider using a pseudo-Boolean constraint solver instead
 void AssertExactlyOne(SolverPtr S,int * lits, int n_lits);
 
+//Number of gates that returned the output of an identical, previously built gate (see -circuit-hash),
+//and number of gates that had to be built.
+uint64_t nCircuitGateHits(SolverPtr S);
+uint64_t nCircuitGateMisses(SolverPtr S);
+
 
 
 #ifdef __cplusplus
@@ -0,0 +1,202 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/api/GNFRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+
+using namespace Monosat;
+
+GNFRecorder::GNFRecorder(FILE * out, bool binary, bool compress, size_t buffer_size) :
+		out(out), binary(binary), failed(false) {
+	//the buffer is split into chunks, so that the writer can be writing one chunk while the next is filled
+	chunk_size = std::max<size_t>(buffer_size / 4, 4096);
+	max_queued_chunks = std::max<size_t>(buffer_size / chunk_size, 1);
+	buffer.reserve(chunk_size + 256);
+	if (compress) {
+		//gzclose closes the descriptor that it is given, so give it a duplicate of out's.
+		//Use the fastest compression level, so that the writer can keep up with the recording.
+		int fd = dup(fileno(out));
+		if (fd >= 0) {
+			gz = gzdopen(fd, "wb1");
+			if (!gz)
+				close(fd);
+		}
+	}
+	if (binary) {
+		fseek(out, 0, SEEK_END);
+		if (ftell(out) == 0) {
+			encoder.encodeHeader();
+			append(encoder.out.data(), encoder.out.size());
+			encoder.out.clear();
+		}
+	}
+	writer = std::thread(&GNFRecorder::writerLoop, this);
+}
+
+GNFRecorder::~GNFRecorder() {
+	flush();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	work_available.notify_one();
+	writer.join();
+	if (gz)
+		gzclose(gz);
+	fclose(out);
+}
+
+bool GNFRecorder::isCompressedFilename(const char * filename) {
+	size_t n = strlen(filename);
+	return n >= 3 && strcmp(filename + n - 3, ".gz") == 0;
+}
+
+bool GNFRecorder::vprintf(const char * fmt, va_list args) {
+	if (!binary) {
+		//format directly into the buffer
+		size_t start = buffer.size();
+		buffer.resize(start + 256);
+		va_list args_copy;
+		va_copy(args_copy, args);
+		int n = vsnprintf(&buffer[start], 256, fmt, args_copy);
+		va_end(args_copy);
+		if (n < 0) {
+			buffer.resize(start);
+			return false;
+		}
+		if (n >= 256) {
+			buffer.resize(start + n + 1);
+			vsnprintf(&buffer[start], n + 1, fmt, args);
+		}
+		buffer.resize(start + n);
+		if (buffer.size() >= chunk_size)
+			submitBuffer();
+		return !failed;
+	}
+	char buf[256];
+	va_list args_copy;
+	va_copy(args_copy, args);
+	int n = vsnprintf(buf, sizeof(buf), fmt, args_copy);
+	va_end(args_copy);
+	if (n < 0)
+		return false;
+	if (n < sizeof(buf))
+		return write(buf, n);
+	std::string long_buf(n + 1, '\0');
+	vsnprintf(&long_buf[0], n + 1, fmt, args);
+	return write(long_buf.data(), n);
+}
+
+bool GNFRecorder::write(const char * data, size_t len) {
+	if (!binary)
+		return writeRaw(data, len);
+	pending.append(data, len);
+	encodePending();
+	if (encoder.out.size()) {
+		append(encoder.out.data(), encoder.out.size());
+		encoder.out.clear();
+	}
+	return !failed;
+}
+
+bool GNFRecorder::writeRaw(const char * data, size_t len) {
+	append(data, len);
+	return !failed;
+}
+
+void GNFRecorder::encodePending() {
+	size_t start = 0;
+	const char * nl;
+	while ((nl = (const char*) memchr(pending.data() + start, '\n', pending.size() - start))) {
+		size_t end = nl - pending.data();
+		encoder.encodeLine(pending.data() + start, end - start);
+		start = end + 1;
+	}
+	pending.erase(0, start);
+}
+
+void GNFRecorder::append(const char * data, size_t len) {
+	buffer.append(data, len);
+	if (buffer.size() >= chunk_size)
+		submitBuffer();
+}
+
+void GNFRecorder::submitBuffer() {
+	if (buffer.empty())
+		return;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		work_done.wait(lock, [&] {return queue.size() < max_queued_chunks;});
+		queue.push_back(std::move(buffer));
+		if (spare.size()) {
+			buffer = std::move(spare.back());
+			spare.pop_back();
+		} else {
+			buffer = std::string();
+			buffer.reserve(chunk_size + 256);
+		}
+	}
+	buffer.clear();
+	work_available.notify_one();
+}
+
+bool GNFRecorder::writeChunk(const std::string & chunk) {
+	if (gz)
+		return gzwrite(gz, chunk.data(), chunk.size()) == (int) chunk.size();
+	return fwrite(chunk.data(), 1, chunk.size(), out) == chunk.size();
+}
+
+void GNFRecorder::writerLoop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		work_available.wait(lock, [&] {return stopping || !queue.empty();});
+		if (queue.empty())
+			return;
+		std::string chunk = std::move(queue.front());
+		queue.pop_front();
+		writing = true;
+		lock.unlock();
+		bool ok = writeChunk(chunk);
+		chunk.clear();
+		lock.lock();
+		if (!ok)
+			failed = true;
+		writing = false;
+		spare.push_back(std::move(chunk));
+		work_done.notify_all();
+	}
+}
+
+bool GNFRecorder::flush() {
+	submitBuffer();
+	std::unique_lock<std::mutex> lock(mutex);
+	work_done.wait(lock, [&] {return queue.empty() && !writing;});
+	//the writer is now idle, and only this thread can give it more work, so the file can be flushed from here
+	if (gz) {
+		if (gzflush(gz, Z_SYNC_FLUSH) != Z_OK)
+			failed = true;
+	}
+	if (fflush(out) != 0)
+		failed = true;
+	return !failed;
+}
@@ -0,0 +1,133 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef GNFRECORDER_H_
+#define GNFRECORDER_H_
+
+#include "monosat/core/BinaryGNF.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+namespace Monosat {
+
+/**
+ * Records the constraints passed to the API (see setOutputFile) as a GNF file, in either text or binary format,
+ * optionally gzip compressed.
+ * Constraints are written as formatted text; in binary mode, each complete line is converted to its binary record.
+ *
+ * Recorded constraints are accumulated in memory, and full chunks are handed off to a background thread that
+ * writes (and compresses) them, so recording only waits on the file if that thread falls behind by more than
+ * the whole buffer. Nothing is guaranteed to have reached the file until flush() is called.
+ * The recorder is not thread safe: only one thread may record constraints at a time.
+ */
+class GNFRecorder {
+	FILE * out;
+	//if non-null, the recording is gzip compressed into 'out' through this stream
+	gzFile gz = nullptr;
+	bool binary;
+	//text of a partially written line (binary mode only)
+	std::string pending;
+	BinaryGNF::Encoder encoder;
+
+	//chunk currently being filled by the recording thread
+	std::string buffer;
+	size_t chunk_size;
+	size_t max_queued_chunks;
+
+	std::mutex mutex;
+	std::condition_variable work_available;
+	std::condition_variable work_done;
+	//full chunks waiting for the writer thread
+	std::deque<std::string> queue;
+	//written chunks, kept to be refilled without reallocating
+	std::vector<std::string> spare;
+	//true while the writer thread is writing a chunk that has already left the queue
+	bool writing = false;
+	bool stopping = false;
+	//set (permanently) if any write to the file has failed
+	std::atomic<bool> failed;
+	std::thread writer;
+
+	void encodePending();
+	void append(const char * data, size_t len);
+	void submitBuffer();
+	bool writeChunk(const std::string & chunk);
+	void writerLoop();
+public:
+	/**
+	 * Record to 'out' (which the recorder takes ownership of). If binary is set and 'out' is empty,
+	 * then the binary GNF header is written first. If compress is set, the recording is gzip compressed.
+	 * Up to buffer_size bytes of recorded constraints may be held in memory before recording blocks on the writer.
+	 */
+	GNFRecorder(FILE * out, bool binary, bool compress = false, size_t buffer_size = 8 << 20);
+	~GNFRecorder();
+
+	GNFRecorder(const GNFRecorder&) = delete;
+	GNFRecorder& operator=(const GNFRecorder&) = delete;
+
+	bool isBinary() const {
+		return binary;
+	}
+
+	bool isCompressed() const {
+		return gz != nullptr;
+	}
+
+	//True if 'filename' should be gzip compressed (that is, if it has the extension '.gz')
+	static bool isCompressedFilename(const char * filename);
+
+	//Returns false if the constraints could not be written (write failures are detected asynchronously,
+	//so a failure may only be reported by a later call, or by flush())
+	bool vprintf(const char * fmt, va_list args);
+
+	bool printf(const char * fmt, ...) {
+		va_list args;
+		va_start(args, fmt);
+		bool ok = vprintf(fmt, args);
+		va_end(args);
+		return ok;
+	}
+
+	bool write(const char * data, size_t len);
+
+	/**
+	 * Write already encoded GNF (text or binary) to the file verbatim.
+	 */
+	bool writeRaw(const char * data, size_t len);
+
+	/**
+	 * Wait until all complete lines recorded so far have been written out, and flush them to the file,
+	 * so that the file can be read by other solvers (or survive the process being killed).
+	 * Returns false if any constraints could not be written.
+	 */
+	bool flush();
+};
+}
+
+#endif /* GNFRECORDER_H_ */
@@ -120,7 +120,7 @@ bool Solve(Lit p, Lit q, Lit r) {
 }
 
 bool Solve() {
-    static vec<Lit> ignore;
+    static thread_local vec<Lit> ignore;
     return Solve(ignore);
 }
 
@@ -34,19 +34,21 @@
 #include "monosat/pb/PbParser.h"
 #include "monosat/amo/AMOParser.h"
 #include "monosat/core/Optimize.h"
+#include "monosat/core/Portfolio.h"
 #include "monosat/pb/PbSolver.h"
 #include "monosat/routing/FlowRouter.h"
 #include "monosat/Version.h"
 #include "MonosatInternal.h"
-#include <csignal>
 #include <ctime>
-#include <set>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <iterator>
 #include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <unistd.h>
 
 using namespace Monosat;
 using namespace std;
@@ -66,96 +68,19 @@ inline void api_errorf(const char *fmt, ...) {
 
 }
 
-static std::set<Solver*> solvers;
-
-#ifndef __APPLE__
-static void solverTimerHandler(int signal, siginfo_t *si, void *uc )
-{
-	timer_t *timer_id = (timer_t *) si->si_value.sival_ptr;
-	//find the solver this timer belongs to, if any
-	for (Solver * S:solvers){
-		assert(S);
-		MonosatData * d = (MonosatData*) S->_external_data;
-		if(d) {
-			if (*timer_id == d->solver_timer){
-				S->interrupt();//interrupt the solver
-				break;
-			}
-		}
-	}
-}
+//Guards the global options, which are (re)parsed each time a solver is created, and which are read by the solver constructor.
+static std::mutex options_mutex;
 
+//Time limits are enforced cooperatively: the solver polls its own deadline (on a monotonic clock) as it searches,
+//rather than being interrupted by a signal or timer thread.
 void enforceTimeLimit(Monosat::SimpSolver * S){
-
-	MonosatData * d = (MonosatData*) S->_external_data;
-	int seconds = d->time_limit;
-	if(seconds<=0){
-		seconds=0; //0 disarms the timer.
-	}
-
-	if (seconds>0 && !d->has_timer){
-		//create a timer if required
-		d->has_timer=true;
-
-		struct sigevent  te;
-		struct itimerspec its;
-		struct sigaction sa;
-		int sigNo = SIGRTMIN;
-
-		/* Set up signal handler. */
-		sa.sa_flags = SA_SIGINFO;
-		sa.sa_sigaction = solverTimerHandler;
-		sigemptyset(&sa.sa_mask);
-
-		if (sigaction(sigNo, &sa, nullptr) == -1)
-		{
-			api_errorf("Failed to install signal handling for timer.");
-		}
-
-		te.sigev_notify = SIGEV_SIGNAL;
-		te.sigev_signo = sigNo;
-		te.sigev_value.sival_ptr = &d->solver_timer;
-		timer_create(CLOCK_REALTIME, &te,&d->solver_timer); //consider also cpu time
-	}
-
-	if(d->has_timer) {
-		struct itimerspec its;
-		its.it_interval.tv_sec = 0;
-		its.it_interval.tv_nsec = 0;
-		its.it_value.tv_sec = seconds;
-		its.it_value.tv_nsec = 0;
-		timer_settime(d->solver_timer, 0, &its, nullptr);
-		d->time_limit = seconds;
-	}
-}
-
-void disableTimeLimit(Monosat::SimpSolver * S){
 	MonosatData * d = (MonosatData*) S->_external_data;
-    if(d->has_timer) {
-        struct itimerspec its;
-        its.it_interval.tv_sec = 0;
-        its.it_interval.tv_nsec = 0;
-        its.it_value.tv_sec = 0;
-        its.it_value.tv_nsec = 0;
-        timer_settime(d->solver_timer, 0, &its, nullptr);
-    }
-}
-
-#endif
-
-#ifdef __APPLE__
-//timer_t and create_timer not supported on OSX,
-//its not clear what a simple alternative would be.
-//So time limits will just not be enforced on OSX at all.
-void enforceTimeLimit(Monosat::SimpSolver * S){
-
-
+	S->setTimeBudget(d->time_limit>0 ? d->time_limit : -1);
 }
 
 void disableTimeLimit(Monosat::SimpSolver * S){
-
+	S->setTimeBudget(-1);
 }
-#endif
 
 //Select which algorithms to apply for graph theory solvers, by parsing command line arguments and defaults.
 void _selectAlgorithms(){
@@ -244,7 +169,9 @@ void _selectAlgorithms(){
 		reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED;
 	} else if (!strcasecmp(opt_reach_alg, "ramal-reps-batch2")) {
         reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED2;
-    } else {
+    } else if (!strcasecmp(opt_reach_alg, "bfs-multi")) {
+		reachalg = ReachAlg::ALG_BFS_MULTI;
+	} else {
 		api_errorf( "Error: unknown reachability algorithm %s, aborting\n", ((string) opt_reach_alg).c_str());
 
 	}
@@ -265,6 +192,8 @@ void _selectAlgorithms(){
 		distalg = DistAlg::ALG_RAMAL_REPS_BATCHED;
 	}else if (!strcasecmp(opt_dist_alg, "ramal-reps-batch2")) {
 		distalg = DistAlg::ALG_RAMAL_REPS_BATCHED2;
+	}else if (!strcasecmp(opt_dist_alg, "astar")) {
+		distalg = DistAlg::ALG_ASTAR;
 	}   else {
 		api_errorf(  "Error: unknown distance algorithm %s, aborting\n", ((string) opt_dist_alg).c_str());
 
@@ -337,13 +266,23 @@ inline void write_out(Monosat::SimpSolver * S, const char *fmt, ...) {
 
 	va_list args;
 	va_start(args, fmt);
-	if( vfprintf(d->outfile,fmt,args)<0){
+	if(!d->outfile->vprintf(fmt,args)){
         va_end(args);
 		api_errorf("Failed to write output");
 	}else {
         va_end(args);
     }
-	fflush(d->outfile);
+}
+
+//Make sure that every constraint recorded so far has reached the output file
+static void flush_out(Monosat::SimpSolver * S){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	if (!d || !d->outfile){
+		return;
+	}
+	if(!d->outfile->flush()){
+		api_errorf("Failed to write output");
+	}
 }
 int varToLit(int variable, bool negated){
 	return toInt(mkLit(variable,negated));
@@ -396,17 +335,50 @@ Var externalBV(Monosat::SimpSolver * S, int bvID){
 void setOutputFile(Monosat::SimpSolver * S,const  char * output){
 	MonosatData * d = (MonosatData*) S->_external_data;
 	assert(d);
-	if(d->outfile){
-		fclose(d->outfile);
+	bool had_previous = d->outfile != nullptr;
+	std::string previous_path = d->outfile_path;
+	bool previous_is_temporary = d->outfile_is_temporary;
+	if(had_previous){
+		delete d->outfile;
 		d->outfile=nullptr;
         d->circuit.setOutputFile(nullptr);
 	}
+	d->outfile_path = "";
+	d->outfile_is_temporary=false;
 	if (output && strlen(output)>0) {
-		d->outfile = fopen(output, "w");
+		//files named *.gnfb are recorded in the binary GNF format, and files named *.gz are compressed
+		bool compress = GNFRecorder::isCompressedFilename(output);
+		std::string uncompressed_name(output, strlen(output) - (compress ? 3 : 0));
+		bool binary = BinaryGNF::isBinaryFilename(uncompressed_name.c_str());
+		FILE * file = fopen(output, binary || compress ? "wb" : "w");
+		if(file){
+			d->outfile = new GNFRecorder(file, binary, compress, (size_t) opt_record_buffer * 1024);
+			d->outfile_path = output;
+		}
+	}
+	if(had_previous && d->outfile && (d->portfolio_size>1 || d->optimization_probes>0)){
+		//Portfolio helpers load the formula from the output file, so it must contain every constraint added so far.
+		//(the previous file is decompressed if necessary, and recompressed if the new file is compressed)
+		gzFile from = gzopen(previous_path.c_str(), "rb");
+		if(!from){
+			api_errorf("Failed to copy constraints from %s",previous_path.c_str());
+		}
+		char buf[65536];
+		int n;
+		while((n = gzread(from, buf, sizeof(buf)))>0){
+			//copied verbatim, so the new file may mix text and binary GNF, which the parser supports
+			d->outfile->writeRaw(buf, n);
+		}
+		gzclose(from);
+		flush_out(S);
+	}else{
+		write_out(S,"c monosat %s\n",d->args.c_str());
+		if(S->const_true!=lit_Undef){
+			write_out(S,"%d 0\n",dimacs(S,S->True()));
+		}
 	}
-	write_out(S,"c monosat %s\n",d->args.c_str());
-	if(S->const_true!=lit_Undef){
-		write_out(S,"%d 0\n",dimacs(S,S->True()));
+	if(previous_is_temporary){
+		unlink(previous_path.c_str());
 	}
 	d->circuit.setOutputFile(d->outfile);
 }
@@ -468,29 +440,9 @@ Monosat::SimpSolver * newSolver_arg(const char*argv){
 }
 
 
-Monosat::SimpSolver * newSolver_args(int argc,  char**argv){
-
-	string args ="";
-	for (int i = 0;i<argc;i++){
-		args.append(" ");
-		args.append(argv[i]);
-	}
-
-	parseOptions(argc, argv, true);
-	if (opt_adaptive_conflict_mincut == 1) {
-		opt_conflict_min_cut = true;
-		opt_conflict_min_cut_maxflow = true;
-	}
-	Monosat::opt_record=strlen(opt_record_file)>0;
-	if(strlen(opt_debug_learnt_clauses)>0){
-		opt_write_learnt_clauses=fopen(opt_debug_learnt_clauses,"w");
-	}else{
-		opt_write_learnt_clauses=nullptr;
-	}
-	_selectAlgorithms();
+//Create a new solver (and its parsers), using the current settings of the global options
+static Monosat::SimpSolver * _newSolver(const string & args){
 	Monosat::SimpSolver * S = new Monosat::SimpSolver();
-	solvers.insert(S);//add S to the list of solvers handled by signals
-
 
 	S->_external_data =(void*)new MonosatData(S);
 	((MonosatData*)S->_external_data)->args =args;
@@ -521,6 +473,50 @@ Monosat::SimpSolver * newSolver_args(int argc,  char**argv){
 		((MonosatData*)S->_external_data)->parser = parser;
 		S->setVarMap(parser);
 	}
+	return S;
+}
+
+Monosat::SimpSolver * newSolver_args(int argc,  char**argv){
+
+	string args ="";
+	for (int i = 0;i<argc;i++){
+		args.append(" ");
+		args.append(argv[i]);
+	}
+
+	std::lock_guard<std::mutex> lock(options_mutex);
+	parseOptions(argc, argv, true);
+	if (opt_adaptive_conflict_mincut == 1) {
+		opt_conflict_min_cut = true;
+		opt_conflict_min_cut_maxflow = true;
+	}
+	Monosat::opt_record=strlen(opt_record_file)>0;
+	if(strlen(opt_debug_learnt_clauses)>0){
+		opt_write_learnt_clauses=fopen(opt_debug_learnt_clauses,"w");
+	}else{
+		opt_write_learnt_clauses=nullptr;
+	}
+	_selectAlgorithms();
+	Monosat::SimpSolver * S = _newSolver(args);
+
+	if(opt_portfolio>1 || opt_optimization_probes>0){
+		MonosatData * d = (MonosatData*)S->_external_data;
+		d->portfolio_size = opt_portfolio;
+		d->optimization_probes = opt_optimization_probes;
+		//The portfolio helpers are loaded from a recording of the constraints added to S,
+		//which (unless the user selects a different output file) is written to a temporary file.
+		const char * tmpdir = getenv("TMPDIR");
+		std::string path = std::string(tmpdir && strlen(tmpdir) ? tmpdir : "/tmp") + "/monosat_portfolio_XXXXXX";
+		std::vector<char> path_buf(path.begin(),path.end());
+		path_buf.push_back('\0');
+		int fd = mkstemp(path_buf.data());
+		if(fd<0){
+			api_errorf("Failed to create temporary file for portfolio solving");
+		}
+		close(fd);
+		setOutputFile(S,path_buf.data());
+		d->outfile_is_temporary=true;
+	}
 	return S ;
 }
 
@@ -529,7 +525,7 @@ void flushFile (Monosat::SimpSolver * S){
     if(S->_external_data){
         MonosatData* data = (MonosatData*) S->_external_data;
         if(data->outfile){
-			fflush(data->outfile);
+			flush_out(S);
         }
     }
 }
@@ -538,7 +534,7 @@ void closeFile (Monosat::SimpSolver * S){
     if(S->_external_data){
         MonosatData* data = (MonosatData*) S->_external_data;
         if(data->outfile){
-			fclose(data->outfile);
+			delete data->outfile;
             data->outfile = nullptr;
 			data->circuit.setOutputFile(nullptr);
         }
@@ -548,22 +544,19 @@ void closeFile (Monosat::SimpSolver * S){
 void deleteSolver (Monosat::SimpSolver * S)
 {
 	S->interrupt();
-	solvers.erase(S);//remove S from the list of solvers in the signal handler
 	if(S->_external_data){
 		MonosatData* data = (MonosatData*) S->_external_data;
-		if(data->has_timer) {
-#ifndef __APPLE__
-			//attempt to delete the timer
-			if (timer_delete(data->solver_timer) == -1) {
-				api_errorf("Failed to delete timer");
-			}
-#endif
-			data->has_timer=false;
-		}
 		if(data->outfile){
-			fclose(data->outfile);
+			delete data->outfile;
 			data->outfile = nullptr;
 		}
+		if(data->outfile_is_temporary){
+			unlink(data->outfile_path.c_str());
+		}
+		for(Monosat::SimpSolver * helper:data->portfolio_helpers){
+			deleteSolver(helper);
+		}
+		data->portfolio_helpers.clear();
 		delete(data);
 		S->_external_data=nullptr;
 	}
@@ -609,7 +602,7 @@ void maximizeLits(Monosat::SimpSolver *  S, int * lits, int n_lits){
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
+	vec<Lit> & lits_opt = d->tmp_lits;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(internalLit(S,lits[i]));
@@ -626,7 +619,7 @@ void minimizeLits(Monosat::SimpSolver *  S, int * lits, int n_lits){
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
+	vec<Lit> & lits_opt = d->tmp_lits;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(internalLit(S,lits[i]));
@@ -643,8 +636,8 @@ void maximizeWeightedLits(Monosat::SimpSolver *  S, int * lits, int * weights, i
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
-	static vec<int> weights_opt;
+	vec<Lit> & lits_opt = d->tmp_lits;
+	vec<int> & weights_opt = d->tmp_ints;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(internalLit(S,lits[i]));
@@ -675,8 +668,8 @@ void minimizeWeightedLits(Monosat::SimpSolver *  S, int * lits, int * weights, i
 	if(n_lits<=0)
 		return;
 	MonosatData * d = (MonosatData*) S->_external_data;
-	static vec<Lit> lits_opt;
-	static vec<int> weights_opt;
+	vec<Lit> & lits_opt = d->tmp_lits;
+	vec<int> & weights_opt = d->tmp_ints;
 	lits_opt.clear();
 	for (int i = 0;i<n_lits;i++){
 		lits_opt.push(internalLit(S,lits[i]));
@@ -769,73 +762,58 @@ void minimizeConflictClause(Monosat::SimpSolver * S){
 }
 //Load a gnf, but ignore any solve/optimize calls
 void loadGNF(Monosat::SimpSolver * S, const char  * filename){
-	gzFile in = gzopen(filename, "rb");
-	if (in == nullptr)
+	StreamBuffer strm(filename, opt_mmap_input);
+	if (!strm.isOpen())
 		throw std::runtime_error("ERROR! Could not open file");
-	try {
-		MonosatData *d = (MonosatData *) S->_external_data;
-		auto &parser = *d->parser;
-		StreamBuffer strm(in);
-
-		d->optimization_objectives.clear();
-		while (parser.parse(strm, *S)) {
-			//ignore solve calls
-		}
-		parser.assumptions.clear();
-		parser.objectives.clear();
+	MonosatData *d = (MonosatData *) S->_external_data;
+	auto &parser = *d->parser;
 
-		assert(*strm == EOF);
-	}catch(...)
-	{
-		gzclose(in);
-		throw;
+	d->optimization_objectives.clear();
+	while (parser.parse(strm, *S)) {
+		//ignore solve calls
 	}
+	parser.assumptions.clear();
+	parser.objectives.clear();
+
+	assert(*strm == EOF);
 }
 //Load a gnf, and run any embedded solve/optimize calls
 void readGNF(Monosat::SimpSolver * S, const char  * filename){
-
-	gzFile in = gzopen(filename, "rb");
-	if (in == nullptr)
+	StreamBuffer strm(filename, opt_mmap_input);
+	if (!strm.isOpen())
 		throw std::runtime_error("ERROR! Could not open file");
-	try {
-		MonosatData *d = (MonosatData *) S->_external_data;
-		auto &parser = *d->parser;
-		StreamBuffer strm(in);
-		vec<int> assumps;
-		bool ran_last_solve = false;
+	MonosatData *d = (MonosatData *) S->_external_data;
+	auto &parser = *d->parser;
+	vec<int> assumps;
+	bool ran_last_solve = false;
+	d->optimization_objectives.clear();
+	while (parser.parse(strm, *S)) {
+		assumps.clear();
+		for (Lit l:parser.assumptions) {
+			assumps.push(externalLit(S, l));
+		}
 		d->optimization_objectives.clear();
-		while (parser.parse(strm, *S)) {
-			assumps.clear();
-			for (Lit l:parser.assumptions) {
-				assumps.push(externalLit(S, l));
-			}
-			d->optimization_objectives.clear();
-			for (Objective &o:parser.objectives) {
-				d->optimization_objectives.push(o);
-			}
+		for (Objective &o:parser.objectives) {
+			d->optimization_objectives.push(o);
+		}
 
-			solveAssumptions(S, &assumps[0], assumps.size());
-			if (*strm == EOF) {
-				ran_last_solve = true;
-			}
+		solveAssumptions(S, &assumps[0], assumps.size());
+		if (*strm == EOF) {
+			ran_last_solve = true;
 		}
-		assert(*strm == EOF);
-		if (!ran_last_solve) {
-			for (Lit l:parser.assumptions) {
-				assumps.push(externalLit(S, l));
-			}
-			d->optimization_objectives.clear();
-			for (Objective &o:parser.objectives) {
-				d->optimization_objectives.push(o);
-			}
-			solveAssumptions(S, &assumps[0], assumps.size());
+	}
+	assert(*strm == EOF);
+	if (!ran_last_solve) {
+		for (Lit l:parser.assumptions) {
+			assumps.push(externalLit(S, l));
 		}
 		d->optimization_objectives.clear();
-	}catch(...)
-	{
-		gzclose(in);
-		throw;
+		for (Objective &o:parser.objectives) {
+			d->optimization_objectives.push(o);
+		}
+		solveAssumptions(S, &assumps[0], assumps.size());
 	}
+	d->optimization_objectives.clear();
 }
 
 Monosat::GraphTheorySolver<int64_t> *  newGraph(Monosat::SimpSolver * S){
@@ -907,11 +885,15 @@ void setTimeLimit(Monosat::SimpSolver * S,int seconds){
 	MonosatData * d = (MonosatData*) S->_external_data;
 
 	if(seconds<=0){
-		seconds=0; //0 disarms the timer.
+		seconds=0; //0 disables the time limit.
 	}
 	d->time_limit = seconds;
 }
 
+void setMemoryLimit(Monosat::SimpSolver * S,int megabytes){
+	S->setMemBudget(megabytes);
+}
+
 void setConflictLimit(Monosat::SimpSolver * S,int num_conflicts){
 	S->setConfBudget(num_conflicts);
 }
@@ -928,10 +910,146 @@ uint64_t nPropagations(Monosat::SimpSolver * S){
 	return S->propagations;
 }
 
+const char * getStatsJSON(Monosat::SimpSolver * S){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	std::stringstream ss;
+	S->writeStatsJSON(ss);
+	d->stats_json = ss.str();
+	return d->stats_json.c_str();
+}
+
 int nLearnedClauses(Monosat::SimpSolver * S){
 	return S->nLearnts();
 }
 
+//Load any constraints that have been appended to the file since the last call (starting from 'offset')
+static void loadRecordedConstraints(Monosat::SimpSolver * S, const char * filename, int64_t & offset){
+	gzFile in = gzopen(filename, "rb");
+	if (in == nullptr)
+		throw std::runtime_error("ERROR! Could not open file");
+	try {
+		MonosatData *d = (MonosatData *) S->_external_data;
+		auto &parser = *d->parser;
+		if(gzseek(in, offset, SEEK_SET)<0){
+			throw std::runtime_error("ERROR! Could not seek in file");
+		}
+		StreamBuffer strm(in);
+		while (parser.parse(strm, *S)) {
+			//ignore solve calls
+		}
+		parser.assumptions.clear();
+		parser.objectives.clear();
+		offset = gztell(in);
+	}catch(...)
+	{
+		gzclose(in);
+		throw;
+	}
+	gzclose(in);
+}
+
+//Create S's first n portfolio helpers, if they do not exist yet.
+static void createPortfolioHelpers(Monosat::SimpSolver * S, int n){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	std::lock_guard<std::mutex> lock(options_mutex);
+	while(d->portfolio_helpers.size()<n){
+		Monosat::SimpSolver * helper = _newSolver(d->args);
+		//the global options may have been changed by other solvers since S was created
+		helper->config = S->config;
+		helper->verbosity=0;
+		helper->diversify(d->portfolio_helpers.size()+1);
+		d->portfolio_helpers.push_back(helper);
+		d->portfolio_helper_offsets.push_back(0);
+	}
+}
+
+//Bring a portfolio helper up to date with the constraints recorded so far, and prepare it to solve.
+static void loadPortfolioHelper(Monosat::SimpSolver * S, int helper_index){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	Monosat::SimpSolver * solver = d->portfolio_helpers[helper_index];
+	loadRecordedConstraints(solver,d->outfile_path.c_str(),d->portfolio_helper_offsets[helper_index]);
+	MonosatData * helper_data = (MonosatData*) solver->_external_data;
+	solver->cancelUntil(0);
+	solver->preprocess();
+	if (helper_data->pbsolver) {
+		helper_data->pbsolver->convert();
+	}
+}
+
+//Solve S in parallel with S's portfolio helpers, each of which solves its own copy of the
+//recorded constraints. Learnt clauses are shared between all the members, and the first member to finish wins.
+//If a helper wins, its answer is transferred back to S (either as S's conflict clause, or by re-solving S
+//with its decision phases seeded from the helper's model, so that S's theories are left with a consistent solution).
+static lbool solvePortfolio(Monosat::SimpSolver * S, const vec<Lit> & assume){
+	MonosatData * d = (MonosatData*) S->_external_data;
+	int n_members = d->portfolio_size;
+	flush_out(S);
+	createPortfolioHelpers(S,n_members-1);
+	vec<int> external_assumptions;
+	for(Lit l:assume){
+		external_assumptions.push(externalLit(S,l));
+	}
+	ClauseExchange exchange(n_members, opt_portfolio_share_size);
+	std::vector<lbool> results(n_members,l_Undef);
+	runPortfolio(n_members,[&](int member){
+		Monosat::SimpSolver * solver = S;
+		lbool r;
+		if(member==0){
+			S->setClauseExchange(&exchange,member);
+			r = S->solveLimited(assume,opt_pre,false);
+		}else{
+			solver = d->portfolio_helpers[member-1];
+			loadPortfolioHelper(S,member-1);
+			if(exchange.isFinished()){
+				return;
+			}
+			vec<Lit> helper_assume;
+			for(int l:external_assumptions){
+				helper_assume.push(internalLit(solver,l));
+			}
+			solver->setClauseExchange(&exchange,member);
+			r = solver->solveLimited(helper_assume,opt_pre,false);
+		}
+		solver->setClauseExchange(nullptr,-1);
+		//if S itself gives up (eg, due to a time or conflict limit), then the whole portfolio gives up.
+		if((r!=l_Undef || member==0) && exchange.finish(member)){
+			results[member]=r;
+		}
+	});
+	int winner = exchange.getWinner();
+	if(winner<=0){
+		return results[0];
+	}
+	Monosat::SimpSolver * helper = d->portfolio_helpers[winner-1];
+	lbool r = results[winner];
+	if(opt_verb>=1){
+		printf("Portfolio solver %d finished first\n",winner);
+	}
+	if(r==l_False){
+		if(helper->conflict.size()==0 && !helper->okay()){
+			//the constraints are unsatisfiable, independently of the assumptions
+			S->addEmptyClause();
+		}
+		S->conflict.clear();
+		for(Lit l:helper->conflict){
+			S->conflict.push(internalLit(S,externalLit(helper,l)));
+		}
+		return l_False;
+	}else{
+		assert(r==l_True);
+		MonosatData * helper_data = (MonosatData*) helper->_external_data;
+		for(Var v = 0;v<helper->model.size();v++){
+			if(helper->model[v]!=l_Undef && helper_data->parser->hasExternalVar(v)){
+				Var sv = internalVar(S,externalVar(helper,v));
+				if(sv<S->nVars()){
+					S->setPolarity(sv,helper->model[v]==l_False);
+				}
+			}
+		}
+		return S->solveLimited(assume,opt_pre,false);
+	}
+}
+
 int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
 	bool found_optimal=true;
 	MonosatData * d = (MonosatData*) S->_external_data;
@@ -944,6 +1062,8 @@ int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
 		write_out(S," %d",dimacs(S,l));
 	}
 	write_out(S,"\n");
+	//each solve call is a durability point for the recording
+	flush_out(S);
 
 	enforceTimeLimit(S);
 
@@ -968,7 +1088,22 @@ int _solve(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
 	if (d->pbsolver) {
 		d->pbsolver->convert();
 	}
-	lbool r = optimize_and_solve(*S, assume,objectives,opt_pre,found_optimal);
+	lbool r;
+	if(d->portfolio_size>1 && d->outfile && !objectives.size()){
+		r = solvePortfolio(S, assume);
+	}else if(d->optimization_probes>0 && d->outfile && objectives.size()){
+		//the portfolio helpers double as the copies on which objective bounds are probed
+		flush_out(S);
+		createPortfolioHelpers(S,d->optimization_probes);
+		runPortfolio(d->optimization_probes,[&](int helper_index){
+			loadPortfolioHelper(S,helper_index);
+		});
+		std::vector<Monosat::SimpSolver*> copies(d->portfolio_helpers.begin(),d->portfolio_helpers.begin()+d->optimization_probes);
+		BoundProber prober(*S,copies);
+		r = optimize_and_solve(*S, assume,objectives,opt_pre,found_optimal,&prober);
+	}else{
+		r = optimize_and_solve(*S, assume,objectives,opt_pre,found_optimal);
+	}
 	disableTimeLimit(S);
 	d->last_solution_optimal=found_optimal;
 	if(r==l_False){
@@ -1218,7 +1353,7 @@ int true_lit(Monosat::SimpSolver * S){
 	return externalLit(S,l);
 }
 bool addClause(Monosat::SimpSolver * S,int * lits, int n_lits){
-	static vec<Lit> clause;
+	vec<Lit> & clause = ((MonosatData*) S->_external_data)->tmp_lits;
 	clause.clear();
 	for (int i = 0;i<n_lits;i++){
 		clause.push(internalLit(S,lits[i]));
@@ -1269,7 +1404,7 @@ int newBitvector_const(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t>
 	return bvID;
 }
 int newBitvector_lazy(SolverPtr S, BVTheoryPtr bv, int * bits, int n_bits){
-    static vec<Var> lits;
+    vec<Var> & lits = ((MonosatData*) S->_external_data)->tmp_vars;
     lits.clear();
     for (int i = 0;i<n_bits;i++){
         Var v =internalVar(S,bits[i]);
@@ -1287,7 +1422,7 @@ int newBitvector_lazy(SolverPtr S, BVTheoryPtr bv, int * bits, int n_bits){
 }
 
 int newBitvector(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> * bv, int * bits, int n_bits){
-	static vec<Var> lits;
+	vec<Var> & lits = ((MonosatData*) S->_external_data)->tmp_vars;
 	lits.clear();
 	for (int i = 0;i<n_bits;i++){
 		Var v =internalVar(S,bits[i]);
@@ -1641,7 +1776,7 @@ void assertPB(Monosat::SimpSolver * S, int _rhs, int n_args, int * literals, int
 			d->pbsolver = new PB::PbSolver(*S);
 		}
 
-		static vec<Lit> lits;
+		vec<Lit> & lits = d->tmp_lits;
 		lits.clear();
 		for (int i = 0; i < n_args; i++) {
 			Lit l = internalLit(S,literals[i]);
@@ -1649,7 +1784,7 @@ void assertPB(Monosat::SimpSolver * S, int _rhs, int n_args, int * literals, int
 			write_out(S,"%d ", dimacs(S,l));
 		}
 		write_out(S,"%d ", n_args);
-		static vec<PB::Int> coefs;
+		vec<PB::Int> & coefs = d->tmp_coefs;
 		coefs.clear();
 		for (int i = 0; i < n_args; i++) {
 			coefs.push(PB::Int(coefficients[i]));
@@ -1943,7 +2078,8 @@ int acyclic_directed(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t>
 
 
 void newEdgeSet(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,int * edges, int n_edges, bool enforceEdgeAssignment){
-	static vec<int> edge_set;
+	MonosatData * d = (MonosatData*) S->_external_data;
+	vec<int> & edge_set = d->tmp_ints;
 	edge_set.clear();
 	write_out(S,"edge_set %d %d", G->getGraphID(), n_edges);
 	for (int i = 0;i<n_edges;i++){
@@ -1966,7 +2102,7 @@ void newEdgeSet(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<int64_t> *G,i
 	}
 	write_out(S,"\n");
 
-	static vec<Lit> edge_lits;
+	vec<Lit> & edge_lits = d->tmp_lits;
 	edge_lits.clear();
 	for(int edgeID:edge_set){
 		edge_lits.push(mkLit(G->toSolver(G->getEdgeVar(edgeID))));
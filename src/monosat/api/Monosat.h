@@ -69,6 +69,9 @@ typedef int64_t Weight;
 	  return lit/2;
   }
  const char * getVersion(void);
+  //Distinct solvers may be used concurrently from different threads, but calls on any one solver must not overlap.
+  //The options parsed when a solver is created are shared by the whole process, except for those in SolverConfig
+  //(see core/Config.h), so solvers that run concurrently should be created with the same values of the other options.
   SolverPtr newSolver(void);
   SolverPtr newSolver_arg(const char*argv);
 #ifndef JNA
@@ -98,8 +101,10 @@ typedef int64_t Weight;
 
   // Sets the (approximate) time limit in seconds before returning l_Undef from solveLimited; ignored by solve().
   // Set to <=0 to disable time limit.
-  // Note that setTimeLimit has no effect on OSX.
+  // The limit is measured in wall-clock time, and is checked by the solver itself (no signals or timers are used).
   void setTimeLimit(SolverPtr S,int seconds);
+  //Sets the maximum memory (in megabytes) that the solver's clause database may reserve before returning l_Undef from solveLimited; ignored by solve(). Set to <0 to disable memory limit.
+  void setMemoryLimit(SolverPtr S,int megabytes);
 
   //Sets the maximum number of (additional) conflicts allowed in the solver before returning l_Undef from solveLimited; ignored by solve(). Set to <0 to disable conflict limit.
   void setConflictLimit(SolverPtr S,int num_conflicts);
@@ -110,6 +115,11 @@ typedef int64_t Weight;
 
   uint64_t nPropagations(SolverPtr S);
 
+  //Returns the solver's statistics as a JSON object, including call counts and time spent in propagation, solving,
+  //reason construction, backtracking and conflict handling for each theory and detector (see -profile).
+  //The returned string remains valid until the next call to getStatsJSON on this solver.
+  const char * getStatsJSON(SolverPtr S);
+
 
   //Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within any resource limits that have been set)
   int solveLimited(SolverPtr S);
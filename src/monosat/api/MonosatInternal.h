@@ -41,34 +41,46 @@
 #include "monosat/pb/PbSolver.h"
 #include "monosat/routing/FlowRouter.h"
 #include "monosat/api/Circuit.h"
+#include "monosat/api/GNFRecorder.h"
 #include <string>
+#include <vector>
 #include <cstdio>
 #include <ctime>
 
 //Helper data structures for the Monosat API, intended for internal use only.
 
-#ifndef __APPLE__
-typedef timer_t posix_timer;
-#else
-//apple doesn't define timer_t
-typedef void* posix_timer;
-#endif
-
 struct MonosatData{
     Monosat::Circuit<Monosat::SimpSolver> circuit;
     Monosat::BVTheorySolver<int64_t> * bv_theory=nullptr;
     Monosat::FSMTheorySolver * fsm_theory=nullptr;
     PB::PbSolver * pbsolver=nullptr;
     int time_limit = -1;
-    bool has_timer = false;
-    posix_timer solver_timer;
     vec< Monosat::GraphTheorySolver<int64_t> *> graphs;
     bool last_solution_optimal=true;
     bool has_conflict_clause_from_last_solution=false;
     vec<Objective> optimization_objectives;
     Dimacs<StreamBuffer, SimpSolver> * parser=nullptr;
-    FILE * outfile =nullptr;
+    Monosat::GNFRecorder * outfile =nullptr;
+    std::string outfile_path = "";
+    bool outfile_is_temporary=false;//true if outfile was created only to support portfolio solving or probing
     std::string args = "";
+    std::string stats_json;//storage for the string returned by getStatsJSON
+    //Portfolio solving (see -portfolio): each helper solver loads the constraints recorded in outfile,
+    //tracking how far into outfile it has read so far.
+    int portfolio_size=1;
+    //Number of helpers used to probe objective bounds concurrently (see -opt-probes); these also load the constraints from outfile.
+    int optimization_probes=0;
+    std::vector<SimpSolver*> portfolio_helpers;
+    std::vector<int64_t> portfolio_helper_offsets;
+    //Scratch space for converting the arguments of API calls. These belong to the instance (rather than being
+    //static), so that distinct solvers can be used from different threads at the same time.
+    vec<Lit> tmp_lits;
+    vec<Lit> tmp_lits_a;
+    vec<Lit> tmp_lits_b;
+    vec<Lit> tmp_lits_c;
+    vec<Var> tmp_vars;
+    vec<int> tmp_ints;
+    vec<PB::Int> tmp_coefs;
     MonosatData(SimpSolver * solver):circuit(*solver){
 
     }
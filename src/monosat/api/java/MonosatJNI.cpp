@@ -409,6 +409,14 @@ JNIEXPORT jlong JNICALL Java_monosat_MonosatJNI_nPropagations
 
 
 
+JNIEXPORT jstring JNICALL Java_monosat_MonosatJNI_getStatsJSON
+        (JNIEnv *env, jclass monosat_class, jlong solverPtr) try {
+    return env->NewStringUTF(getStatsJSON(reinterpret_cast<SolverPtr>(solverPtr)));
+}catch(...) {
+    javaThrow(env);
+    return nullptr;
+}
+
 JNIEXPORT jint JNICALL Java_monosat_MonosatJNI_solveLimited
         (JNIEnv *env, jclass monosat_class, jlong solverPtr) try {
     return solveLimited(reinterpret_cast<SolverPtr>(solverPtr));
@@ -169,6 +169,9 @@ final class MonosatJNI { // package level access specifier
   //number of propagation rounds in the solver
   public static native long nPropagations(long solverPtr);
 
+  // solver statistics, including per-theory profiling counters, as a JSON object
+  public static native String getStatsJSON(long solverPtr);
+
   // Returns 0 for satisfiable, 1 for proved unsatisfiable, 2 for failed to find a solution (within
   // any resource limits that have been set)
   public static native int solveLimited(long solverPtr);
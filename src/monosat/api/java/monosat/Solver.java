@@ -973,6 +973,15 @@ public final class Solver implements Closeable {
     return MonosatJNI.nPropagations(getSolverPtr());
   }
 
+  /**
+   * Get the solver's statistics as a JSON object, including the number of calls to, and time spent in,
+   * propagation, solving, reason construction, backtracking and conflict handling for each theory and detector.
+   * @return The solver's statistics, as a JSON string.
+   */
+  public String getStatsJSON(){
+    return MonosatJNI.getStatsJSON(getSolverPtr());
+  }
+
   /**
    * Sets the maximum number of (further) propagation rounds allowed in the solver before returning
    * empty from solveLimited(); ignored by solve(). Set to <0 to disable propagation
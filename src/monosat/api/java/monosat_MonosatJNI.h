@@ -287,6 +287,14 @@ JNIEXPORT void JNICALL Java_monosat_MonosatJNI_setPropagationLimit
 JNIEXPORT jlong JNICALL Java_monosat_MonosatJNI_nPropagations
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     monosat_MonosatJNI
+ * Method:    getStatsJSON
+ * Signature: (J)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_monosat_MonosatJNI_getStatsJSON
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     monosat_MonosatJNI
  * Method:    solveLimited
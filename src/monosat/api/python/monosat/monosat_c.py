@@ -252,6 +252,7 @@ class Monosat(metaclass=Singleton):
             self.monosat_c.minimizeConflictClause.argtypes = [c_solver_p]
 
             self.monosat_c.setTimeLimit.argtypes = [c_solver_p, c_int]
+            self.monosat_c.setMemoryLimit.argtypes = [c_solver_p, c_int]
 
             self.monosat_c.setConflictLimit.argtypes = [c_solver_p, c_int]
             self.monosat_c.setPropagationLimit.argtypes = [c_solver_p, c_int]
@@ -996,6 +997,12 @@ class Monosat(metaclass=Singleton):
 
 
 
+    def setMemoryLimit(self, megabytes):
+        if megabytes is None or megabytes < 0:
+            self.monosat_c.setMemoryLimit(self.solver._ptr, -1)
+        else:
+            self.monosat_c.setMemoryLimit(self.solver._ptr, megabytes)
+
     def setConflictLimit(self, conflicts):
         if conflicts is None or conflicts < 0:
             self.monosat_c.setConflictLimit(self.solver._ptr, -1)
@@ -0,0 +1,347 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+/**
+ * Benchmark harness for the dynamic graph algorithms used by the graph theory solver.
+ *
+ * Generates a grid, random or power-law graph, and a scripted sequence of edge enable/disable batches,
+ * then replays the same sequence against each selected algorithm, timing each incremental update.
+ * Reports per-update latency percentiles, so that the -reach, -maxflow and -mst options can be compared
+ * on graphs resembling a given application.
+ *
+ * Example:
+ *  graph_benchmark -graph=grid -width=200 -height=200 -updates=2000 -batch=4 -algs=bfs,ramal-reps,dinitz,kohli-torr
+ */
+
+#include "monosat/utils/Options.h"
+#include "monosat/utils/System.h"
+#include "monosat/dgl/DynamicGraph.h"
+#include "monosat/dgl/BFS.h"
+#include "monosat/dgl/Dijkstra.h"
+#include "monosat/dgl/RamalReps.h"
+#include "monosat/dgl/MultiSourceBFS.h"
+#include "monosat/dgl/Dinics.h"
+#include "monosat/dgl/DinicsLinkCut.h"
+#include "monosat/dgl/KohliTorr.h"
+#include "monosat/dgl/EdmondsKarpDynamic.h"
+#include "monosat/dgl/EdmondsKarpAdj.h"
+#include "monosat/dgl/Kruskal.h"
+#include "monosat/dgl/Prim.h"
+#include "monosat/dgl/SpiraPan.h"
+#include "monosat/dgl/alg/Rnd.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dgl;
+using namespace Monosat;
+
+typedef int64_t Weight;
+
+struct EdgeSpec {
+	int from;
+	int to;
+	Weight weight;
+};
+
+//A generated graph, together with the sequence of edges to toggle in each update
+struct Workload {
+	int n_nodes = 0;
+	std::vector<EdgeSpec> edges;
+	std::vector<bool> initially_enabled;
+	std::vector<std::vector<int>> batches;
+	int source = 0;
+	int sink = 0;
+};
+
+static void generateGrid(Workload & w, int width, int height, Weight max_weight, double & seed) {
+	w.n_nodes = width * height;
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			int n = y * width + x;
+			if (x + 1 < width) {
+				w.edges.push_back( { n, n + 1, 1 + alg::irand(seed, max_weight) });
+				w.edges.push_back( { n + 1, n, 1 + alg::irand(seed, max_weight) });
+			}
+			if (y + 1 < height) {
+				w.edges.push_back( { n, n + width, 1 + alg::irand(seed, max_weight) });
+				w.edges.push_back( { n + width, n, 1 + alg::irand(seed, max_weight) });
+			}
+		}
+	}
+	w.source = 0;
+	w.sink = w.n_nodes - 1;
+}
+
+static void generateRandom(Workload & w, int n_nodes, double degree, Weight max_weight, double & seed) {
+	w.n_nodes = n_nodes;
+	int64_t n_edges = (int64_t) (n_nodes * degree);
+	for (int64_t i = 0; i < n_edges; i++) {
+		int from = alg::irand(seed, n_nodes);
+		int to = alg::irand(seed, n_nodes);
+		w.edges.push_back( { from, to, 1 + alg::irand(seed, max_weight) });
+	}
+	w.source = 0;
+	w.sink = n_nodes - 1;
+}
+
+//Preferential attachment (Barabasi-Albert): each new node connects to 'degree' existing nodes, chosen with
+//probability proportional to their current degree, giving a power-law degree distribution.
+static void generatePowerLaw(Workload & w, int n_nodes, int degree, Weight max_weight, double & seed) {
+	w.n_nodes = n_nodes;
+	std::vector<int> endpoints;//each node appears once per incident edge
+	endpoints.push_back(0);
+	for (int n = 1; n < n_nodes; n++) {
+		for (int i = 0; i < degree; i++) {
+			int other = endpoints[alg::irand(seed, endpoints.size())];
+			if (alg::drand(seed) < 0.5) {
+				w.edges.push_back( { n, other, 1 + alg::irand(seed, max_weight) });
+			} else {
+				w.edges.push_back( { other, n, 1 + alg::irand(seed, max_weight) });
+			}
+			endpoints.push_back(other);
+			endpoints.push_back(n);
+		}
+	}
+	//use a high degree hub as the source, and the most recent (lowest degree) node as the sink
+	w.source = 0;
+	w.sink = n_nodes - 1;
+}
+
+static void generateScript(Workload & w, double enabled_fraction, int n_updates, int batch_size, double & seed) {
+	w.initially_enabled.resize(w.edges.size());
+	for (int i = 0; i < w.edges.size(); i++)
+		w.initially_enabled[i] = alg::drand(seed) < enabled_fraction;
+	w.batches.resize(n_updates);
+	for (auto & batch : w.batches) {
+		for (int i = 0; i < batch_size; i++)
+			batch.push_back(alg::irand(seed, w.edges.size()));
+	}
+}
+
+static void buildGraph(const Workload & w, DynamicGraph<Weight> & g) {
+	g.addNodes(w.n_nodes);
+	for (int i = 0; i < w.edges.size(); i++) {
+		g.addEdge(w.edges[i].from, w.edges[i].to, i, w.edges[i].weight);
+		if (!w.initially_enabled[i])
+			g.disableEdge(i);
+	}
+}
+
+//An algorithm under test: update() brings it up to date with the graph, and returns a value summarizing its result
+//(so that the work cannot be optimized away, and so that algorithms computing the same property can be cross-checked).
+struct Benchmark {
+	std::function<int64_t()> update;
+	std::vector<std::shared_ptr<void>> owned;
+};
+
+static bool makeBenchmark(const std::string & name, DynamicGraph<Weight> & g, const Workload & w, int n_sources,
+						  Benchmark & b) {
+	int s = w.source;
+	int t = w.sink;
+	if (name == "bfs") {
+		auto alg = std::make_shared<BFSReachability<Weight>>(s, g);
+		b.owned.push_back(alg);
+		b.update = [alg, t]() {alg->update(); return (int64_t) alg->connected(t);};
+	} else if (name == "dijkstra") {
+		auto alg = std::make_shared<Dijkstra<Weight>>(s, g);
+		b.owned.push_back(alg);
+		b.update = [alg, t]() {alg->update(); return (int64_t) alg->connected(t);};
+	} else if (name == "ramal-reps") {
+		auto alg = std::make_shared<RamalReps<Weight>>(s, g);
+		b.owned.push_back(alg);
+		b.update = [alg, t]() {alg->update(); return (int64_t) alg->connected(t);};
+	} else if (name == "unweighted-ramal-reps") {
+		auto alg = std::make_shared<UnweightedRamalReps<Weight>>(s, g);
+		b.owned.push_back(alg);
+		b.update = [alg, t]() {alg->update(); return (int64_t) alg->connected(t);};
+	} else if (name == "bfs-many") {
+		//one independent BFS per source, for comparison with bfs-multi
+		auto algs = std::make_shared<std::vector<std::unique_ptr<BFSReachability<Weight>>>>();
+		for (int i = 0; i < n_sources; i++)
+			algs->emplace_back(new BFSReachability<Weight>((s + i) % g.nodes(), g));
+		b.owned.push_back(algs);
+		b.update = [algs, t]() {
+			int64_t n = 0;
+			for (auto & alg : *algs) {
+				alg->update();
+				n += alg->connected(t);
+			}
+			return n;
+		};
+	} else if (name == "bfs-multi") {
+		auto shared = std::make_shared<MultiSourceBFS<Weight>>(g);
+		for (int i = 0; i < n_sources; i++)
+			shared->addSource((s + i) % g.nodes());
+		b.owned.push_back(shared);
+		b.update = [shared, t]() {
+			shared->update();
+			int64_t n = 0;
+			for (int lane = 0; lane < shared->nSources(); lane++)
+				n += shared->connected_unsafe(lane, t);
+			return n;
+		};
+	} else if (name == "dinitz") {
+		std::shared_ptr<MaxFlow<Weight>> alg = std::make_shared<Dinitz<Weight>>(g, s, t);
+		b.owned.push_back(alg);
+		b.update = [alg]() {return (int64_t) alg->maxFlow();};
+	} else if (name == "dinitz-linkcut") {
+		std::shared_ptr<MaxFlow<Weight>> alg = std::make_shared<DinitzLinkCut<Weight>>(g, s, t);
+		b.owned.push_back(alg);
+		b.update = [alg]() {return (int64_t) alg->maxFlow();};
+	} else if (name == "kohli-torr") {
+		std::shared_ptr<MaxFlow<Weight>> alg = std::make_shared<KohliTorr<Weight>>(g, s, t, false);
+		b.owned.push_back(alg);
+		b.update = [alg]() {return (int64_t) alg->maxFlow();};
+	} else if (name == "edmonds-karp-dynamic") {
+		std::shared_ptr<MaxFlow<Weight>> alg = std::make_shared<EdmondsKarpDynamic<Weight>>(g, s, t);
+		b.owned.push_back(alg);
+		b.update = [alg]() {return (int64_t) alg->maxFlow();};
+	} else if (name == "edmonds-karp") {
+		std::shared_ptr<MaxFlow<Weight>> alg = std::make_shared<EdmondsKarpAdj<Weight>>(g, s, t);
+		b.owned.push_back(alg);
+		b.update = [alg]() {return (int64_t) alg->maxFlow();};
+	} else if (name == "kruskal") {
+		auto alg = std::make_shared<Kruskal<MinimumSpanningTree<Weight>::NullStatus, Weight>>(g);
+		b.owned.push_back(alg);
+		b.update = [alg]() {alg->update(); return (int64_t) alg->weight();};
+	} else if (name == "prim") {
+		auto alg = std::make_shared<Prim<MinimumSpanningTree<Weight>::NullStatus, Weight>>(g,
+				MinimumSpanningTree<Weight>::nullStatus);
+		b.owned.push_back(alg);
+		b.update = [alg]() {alg->update(); return (int64_t) alg->weight();};
+	} else if (name == "spira-pan") {
+		auto alg = std::make_shared<SpiraPan<MinimumSpanningTree<Weight>::NullStatus, Weight>>(g,
+				MinimumSpanningTree<Weight>::nullStatus);
+		b.owned.push_back(alg);
+		b.update = [alg]() {alg->update(); return (int64_t) alg->weight();};
+	} else {
+		return false;
+	}
+	return true;
+}
+
+static double percentile(const std::vector<double> & sorted, double p) {
+	if (sorted.size() == 0)
+		return 0;
+	size_t i = std::min(sorted.size() - 1, (size_t) (p * (sorted.size() - 1) + 0.5));
+	return sorted[i];
+}
+
+int main(int argc, char** argv) {
+	setUsageHelp(
+			"USAGE: %s [options]\n\n  Times incremental updates of the dynamic graph algorithms on generated graphs.\n");
+
+	StringOption opt_graph_type("BENCH", "graph", "Graph to generate (grid, random, powerlaw)", "grid");
+	IntOption opt_width("BENCH", "width", "Width of grid graphs", 100, IntRange(1, INT32_MAX));
+	IntOption opt_height("BENCH", "height", "Height of grid graphs", 100, IntRange(1, INT32_MAX));
+	IntOption opt_nodes("BENCH", "nodes", "Number of nodes in random and power-law graphs", 10000,
+						IntRange(2, INT32_MAX));
+	DoubleOption opt_degree("BENCH", "degree", "Average out-degree of random and power-law graphs", 4,
+							DoubleRange(0, false, HUGE_VAL, false));
+	IntOption opt_max_weight("BENCH", "max-weight", "Edge weights (and capacities) are chosen uniformly in 1..max-weight",
+							 10, IntRange(1, INT32_MAX));
+	DoubleOption opt_enabled("BENCH", "enabled", "Fraction of edges initially enabled", 0.9,
+							 DoubleRange(0, true, 1, true));
+	IntOption opt_updates("BENCH", "updates", "Number of timed updates", 1000, IntRange(1, INT32_MAX));
+	IntOption opt_batch("BENCH", "batch", "Number of edges toggled (enabled if disabled, or vice versa) before each update",
+						1, IntRange(1, INT32_MAX));
+	IntOption opt_sources("BENCH", "sources", "Number of sources for bfs-many and bfs-multi", 64,
+						  IntRange(1, INT32_MAX));
+	StringOption opt_algs("BENCH", "algs",
+						  "Comma separated list of algorithms to run (bfs, dijkstra, ramal-reps, unweighted-ramal-reps, bfs-many, bfs-multi, dinitz, dinitz-linkcut, kohli-torr, edmonds-karp-dynamic, edmonds-karp, kruskal, prim, spira-pan)",
+						  "bfs,dijkstra,ramal-reps,dinitz,kohli-torr,edmonds-karp-dynamic,kruskal,spira-pan");
+	DoubleOption opt_seed("BENCH", "seed", "Random seed for graph and script generation", 91648253,
+						  DoubleRange(0, false, HUGE_VAL, false));
+	BoolOption opt_csv("BENCH", "csv", "Print results as comma separated values", false);
+
+	parseOptions(argc, argv, true);
+
+	double seed = opt_seed;
+	Workload w;
+	if (!strcasecmp(opt_graph_type, "grid")) {
+		generateGrid(w, opt_width, opt_height, opt_max_weight, seed);
+	} else if (!strcasecmp(opt_graph_type, "random")) {
+		generateRandom(w, opt_nodes, opt_degree, opt_max_weight, seed);
+	} else if (!strcasecmp(opt_graph_type, "powerlaw")) {
+		generatePowerLaw(w, opt_nodes, std::max(1, (int) (opt_degree + 0.5)), opt_max_weight, seed);
+	} else {
+		fprintf(stderr, "Error: unknown graph type %s\n", (const char*) opt_graph_type);
+		return 1;
+	}
+	generateScript(w, opt_enabled, opt_updates, opt_batch, seed);
+
+	if (!opt_csv) {
+		printf("%s graph: %d nodes, %d edges; %d updates of %d edge(s) each\n", (const char*) opt_graph_type, w.n_nodes,
+			   (int) w.edges.size(), (int) opt_updates, (int) opt_batch);
+		printf("%-22s %12s %10s %10s %10s %10s %10s %12s\n", "algorithm", "initial(ms)", "mean(us)", "p50(us)", "p90(us)",
+			   "p99(us)", "max(us)", "checksum");
+	} else {
+		printf("algorithm,initial_ms,mean_us,p50_us,p90_us,p99_us,max_us,checksum\n");
+	}
+
+	std::stringstream algs((const char*) opt_algs);
+	std::string name;
+	while (std::getline(algs, name, ',')) {
+		if (name.empty())
+			continue;
+		//every algorithm replays the same script on its own copy of the graph
+		DynamicGraph<Weight> g;
+		buildGraph(w, g);
+		Benchmark b;
+		if (!makeBenchmark(name, g, w, opt_sources, b)) {
+			fprintf(stderr, "Error: unknown algorithm %s\n", name.c_str());
+			return 1;
+		}
+		typedef std::chrono::steady_clock Clock;
+		auto start = Clock::now();
+		int64_t checksum = b.update();
+		double initial_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		std::vector<double> latencies;
+		latencies.reserve(w.batches.size());
+		for (auto & batch : w.batches) {
+			for (int edgeID : batch)
+				g.setEdgeEnabled(edgeID, !g.edgeEnabled(edgeID));
+			start = Clock::now();
+			checksum += b.update();
+			latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+			g.clearHistory();
+		}
+		double total = 0;
+		for (double l : latencies)
+			total += l;
+		std::sort(latencies.begin(), latencies.end());
+		const char * fmt = opt_csv ?
+				"%s,%f,%f,%f,%f,%f,%f,%" PRId64 "\n" : "%-22s %12.3f %10.2f %10.2f %10.2f %10.2f %10.2f %12" PRId64 "\n";
+		printf(fmt, name.c_str(), initial_ms, total / latencies.size(), percentile(latencies, 0.5),
+			   percentile(latencies, 0.9), percentile(latencies, 0.99), latencies.back(), checksum);
+		fflush(stdout);
+	}
+	return 0;
+}
@@ -3178,9 +3178,9 @@ public:
 			vec<Lit> &bv_a = theory.bitvectors[aID];
 			vec<Lit> &bv_b = theory.bitvectors[bID];
 
-			static vec<Lit> tmp_a;
-			static vec<Lit> tmp_b;
-			static vec<Lit> tmp_c;
+			static thread_local vec<Lit> tmp_a;
+			static thread_local vec<Lit> tmp_b;
+			static thread_local vec<Lit> tmp_c;
 			tmp_a.clear();
 			tmp_b.clear();
 			tmp_c.clear();
@@ -3193,7 +3193,7 @@ public:
 			for (Lit l:bv) {
 				tmp_c.push(toSolver(l));
 			}
-			static vec<Lit> store;
+			static thread_local vec<Lit> store;
 			store.clear();
 			Lit carry = lit_Undef;
 			c.Add(tmp_a, tmp_b, store, carry);
@@ -3291,16 +3291,37 @@ public:
 			return true;
 
 		}
-		void updateApprox(Var ignore_bv, Weight & under_new, Weight & over_new, Cause & under_cause_new, Cause & over_cause_new) override{
+		//Bounds on the sum implied by the arguments: their bounds, tightened (if the sum cannot saturate)
+		//by the bits of the sum that are fixed by the known bits of the arguments.
+		//Returns true if the known bits tightened either bound.
+		bool computeBounds(Weight & under, Weight & over){
 			importTheory(theory);
 			int aID=arg1->bvID;
 			int bID=arg2->bvID;
-			//assert(aID<bvID);
-			//assert(bID<bvID);
-			Weight under = under_approx[aID] +  under_approx[bID];
-			Weight over = over_approx[aID] +  over_approx[bID];
-			clip_over(under,bvID);
-			clip_over(over,bvID);
+			under = under_approx[aID] +  under_approx[bID];
+			over = over_approx[aID] +  over_approx[bID];
+			int width = theory.bitvectors[bvID].size();
+			Weight max_val = evalBit<Weight>(width)-1;
+			if(!opt_bv_known_bits || over>max_val){
+				clip_over(under,bvID);
+				clip_over(over,bvID);
+				return false;
+			}
+			uint64_t known_zero;
+			uint64_t known_one;
+			if(!theory.knownBitsAdd(aID,bID,known_zero,known_one)){
+				return false;
+			}
+			return theory.refineKnownBits(bvID,known_zero,known_one,under,over);
+		}
+
+		void updateApprox(Var ignore_bv, Weight & under_new, Weight & over_new, Cause & under_cause_new, Cause & over_cause_new) override{
+			importTheory(theory);
+			Weight under;
+			Weight over;
+			if(computeBounds(under,over)){
+				theory.stats_known_bits_refinements++;
+			}
 			if(under >under_new){
 				under_new=under;
 				under_cause_new.clear();
@@ -3364,6 +3385,20 @@ public:
 
 		void analyzeReason(bool compareOver,Comparison op, Weight  to,  vec<Lit> & conflict)override{
 			importTheory(theory);
+			if(opt_bv_known_bits){
+				int aID=arg1->bvID;
+				int bID=arg2->bvID;
+				Weight under_add = under_approx[aID] +  under_approx[bID];
+				Weight over_add = over_approx[aID] +  over_approx[bID];
+				clip_over(under_add,bvID);
+				clip_over(over_add,bvID);
+				if((compareOver && over_add>over_approx[bvID]) || (!compareOver && under_add<under_approx[bvID])){
+					//the bounds of the arguments alone don't imply this bound, so it came from their known bits
+					theory.analyzeKnownBitsReason(aID,conflict);
+					theory.analyzeKnownBitsReason(bID,conflict);
+					return;
+				}
+			}
 			if(compareOver){
 
 				int aID=arg1->bvID;
@@ -3511,10 +3546,9 @@ public:
 				theory.stats_conflict_time+=rtime(2)-startconftime;
 				return false;
 			}
-			Weight under_arg = underApprox + under_approx[other_argID];
-			clip_over(under_arg,bvID);
-			Weight over_arg =  overApprox + over_approx[other_argID];
-			clip_over(over_arg,bvID);
+			Weight under_arg;
+			Weight over_arg;
+			resultOp->computeBounds(under_arg,over_arg);
 			//this check may be especially important when either aID or bID is really a constant...
 			if((under_arg > under_approx[sumID]) || (over_arg< over_approx[sumID])){
 				//the other bv needs to be updated
@@ -4539,20 +4573,38 @@ public:
 
 		}
 
-		void updateApprox(Var ignore_bv, Weight &under_new, Weight &over_new, Cause &under_cause_new,
-						  Cause &over_cause_new) override {
+		//Bounds on the product implied by the arguments: their bounds, tightened (if the product cannot saturate)
+		//by the bits of the product that are fixed by the known bits of the arguments.
+		//Returns true if the known bits tightened either bound.
+		bool computeBounds(Weight &under, Weight &over) {
 			importTheory(theory);
 			int aID = arg1->bvID;
 			int bID = arg2->bvID;
-            if(bvID==565){
-                int a =1;
-            }
-			//assert(aID<bvID);
-			//assert(bID<bvID);
-			Weight under = under_approx[aID] * under_approx[bID];
-			Weight over = over_approx[aID] * over_approx[bID] ;
+			under = under_approx[aID] * under_approx[bID];
+			over = over_approx[aID] * over_approx[bID];
 			clip_over(under, bvID);
 			clip_over(over, bvID);
+			int width = theory.bitvectors[bvID].size();
+			Weight max_val = evalBit<Weight>(width)-1;
+			if (!opt_bv_known_bits || (over_approx[aID] > 0 && over_approx[bID] > max_val / over_approx[aID])) {
+				return false;
+			}
+			uint64_t known_zero;
+			uint64_t known_one;
+			if (!theory.knownBitsMultiply(aID, bID, known_zero, known_one)) {
+				return false;
+			}
+			return theory.refineKnownBits(bvID, known_zero, known_one, under, over);
+		}
+
+		void updateApprox(Var ignore_bv, Weight &under_new, Weight &over_new, Cause &under_cause_new,
+						  Cause &over_cause_new) override {
+			importTheory(theory);
+			Weight under;
+			Weight over;
+			if (computeBounds(under, over)) {
+				theory.stats_known_bits_refinements++;
+			}
 			if (under > under_new) {
 				under_new = under;
 				under_cause_new.clear();
@@ -4622,6 +4674,18 @@ public:
 			importTheory(theory);
 			int aID = arg1->bvID;
 			int bID = arg2->bvID;
+			if (opt_bv_known_bits) {
+				Weight under_mult = under_approx[aID] * under_approx[bID];
+				Weight over_mult = over_approx[aID] * over_approx[bID];
+				clip_over(under_mult, bvID);
+				clip_over(over_mult, bvID);
+				if ((compareOver && over_mult > over_approx[bvID]) || (!compareOver && under_mult < under_approx[bvID])) {
+					//the bounds of the arguments alone don't imply this bound, so it came from their known bits
+					theory.analyzeKnownBitsReason(aID, conflict);
+					theory.analyzeKnownBitsReason(bID, conflict);
+					return;
+				}
+			}
 
 			if (compareOver) {
 				Weight over_bid = over_approx[bID];
@@ -4787,10 +4851,9 @@ public:
 				//the other bv needs to be updated
 				addAlteredBV(other_argID);
 			}
-            Weight under_sum = underApprox * under_approx[other_argID];
-            clip_over(under_sum, bvID);
-            Weight over_sum = overApprox * over_approx[other_argID];
-            clip_over(over_sum, bvID);
+            Weight under_sum;
+            Weight over_sum;
+            resultOp->computeBounds(under_sum, over_sum);
             if ((under_sum > under_approx[sumID]) || (over_sum < over_approx[sumID])) {
                 //the other bv needs to be updated
 
@@ -5068,6 +5131,8 @@ public:
 	CRef conditionarg_prop_marker;
 	CRef bvprop_marker;
 	CRef popcount_marker;
+	CRef knownbits_marker;
+	vec<int> knownbits_causes;//for each bit assigned by known bits propagation, the operation that derived it
 	Lit const_true=lit_Undef;
 	vec<int> named_bvs;//all bit vectors with names, in the order they were created
 	std::vector<std::vector<std::string>> symbols;
@@ -5189,6 +5254,8 @@ public:
     int64_t stats_mult_conflicts=0;
 	int64_t stats_bit_conflicts = 0;
 	int64_t stats_addition_conflicts = 0;
+	int64_t stats_known_bits_conflicts = 0;
+	int64_t stats_known_bits_propagations = 0;
 	int64_t stats_compare_conflicts = 0;
 	int64_t stats_bv_compare_conflicts = 0;
 	int64_t stats_decisions = 0;
@@ -5199,6 +5266,7 @@ public:
 	int64_t stats_build_condition_arg_reason = 0;
 	int64_t stats_build_addition_reason = 0;
 	int64_t stats_build_addition_arg_reason = 0;
+	int64_t stats_known_bits_refinements = 0;
 	double stats_update_time=0;
 	double reachupdatetime = 0;
 	double unreachupdatetime = 0;
@@ -5233,6 +5301,7 @@ public:
 		bvprop_marker = S->newReasonMarker(this);
 		popcount_marker = S->newReasonMarker(this);
         unary_prop_marker = S->newReasonMarker(this);
+		knownbits_marker = S->newReasonMarker(this);
 		const_true = True();
 	}
 	~BVTheorySolver() override {
@@ -5301,6 +5370,10 @@ public:
 		printf("Reasons: %" PRId64 " (%f s, avg: %f s)\n", stats_num_reasons, stats_reason_time,
 				(stats_reason_time) / ((double) stats_num_reasons + 1));
 		printf("Build: value reason %" PRId64 ", bv value reason %" PRId64 ", addition reason %" PRId64 "\n", stats_build_value_reason,stats_build_value_bv_reason,stats_build_addition_reason);
+		if(opt_bv_known_bits){
+			printf("Known bits: %" PRId64 " bound refinements\n", stats_known_bits_refinements);
+		}
+		printf("Known bits: %" PRId64 " propagations, %" PRId64 " conflicts\n", stats_known_bits_propagations,stats_known_bits_conflicts);
 
 		fflush(stdout);
 	}
@@ -6152,7 +6225,7 @@ public:
 	;
 
 	void buildReason(Lit p, vec<Lit> & reason,CRef marker) override {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if(++iter==39){//17
 			int a =1;
 		}
@@ -6167,7 +6240,8 @@ public:
 		rewind_trail_pos(trail.size());
 
 		//if the reason is being constructed eagerly, then p won't be assigned yet, and so wont be on the trail, so we skip this.
-		rewindUntil(var(p));
+		if(marker!=knownbits_marker || value(p)!=l_Undef)
+			rewindUntil(var(p));
 
 		assert(value(p)!=l_False);
 		//now that we have backtracked, we need to update the under/over approximations.
@@ -6178,7 +6252,8 @@ public:
 			updateApproximations(bvID);
 		}*/
 		assert(hasOperation(p));
-		Operation & op = getOperation(p);
+		//bits assigned by known bits propagation are explained by the operation that derived them, rather than by their own bitvector
+		Operation & op = marker==knownbits_marker ? getOperation(knownbits_causes[var(p)]) : getOperation(p);
 		op.buildReason(p,marker,reason);
 		//note: the reason has already been transformed into the solvers variable namespace at this point,
 		//do _not_ call 'toSolver' again
@@ -6406,7 +6481,7 @@ public:
 
 		double update_start_time= rtime(3);
 		statis_bv_updates++;
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 
 
@@ -6606,7 +6681,7 @@ public:
 
 	void writeBounds(int bvID){
 		if(opt_write_learnt_clauses && opt_write_bv_bounds){
-			static int bound_num=0;
+			static thread_local int bound_num=0;
 			if(++opt_n_learnts==44231){
 				int a=1;
 			}
@@ -6688,6 +6763,160 @@ public:
 			bvID=eq_bitvectors[bvID];
 		return bitvectors[bvID];
 	}
+
+	static uint64_t lowBits(int n){
+		return n>=64 ? ~((uint64_t)0) : (((uint64_t)1)<<n)-1;
+	}
+
+	static int trailingOnes(uint64_t x){
+		int n = 0;
+		while(n<64 && (x & (((uint64_t)1)<<n))){
+			n++;
+		}
+		return n;
+	}
+
+	//Collect the bits of bvID that are fixed, either by an assigned bit literal, or because every value
+	//between the under and over approximation agrees on them. Bits above the width are reported as known zero.
+	//Returns false if the bit assignments contradict the bounds.
+	bool getKnownBits(int bvID, uint64_t & known_zero, uint64_t & known_one){
+		vec<Lit> & bv = getBits(bvID);
+		uint64_t mask = lowBits(bv.size());
+		uint64_t under = getLong(under_approx[bvID]);
+		uint64_t over = getLong(over_approx[bvID]);
+		uint64_t fixed = 0;
+		if(under<=over){
+			//every bit above the highest bit in which under and over differ is shared by all values in between
+			int differ = 0;
+			while(differ<64 && ((under^over)>>differ)){
+				differ++;
+			}
+			fixed = mask & ~lowBits(differ);
+		}
+		known_one = under & fixed;
+		known_zero = (~under & fixed) | ~mask;
+		for(int i = 0;i<bv.size();i++){
+			lbool val = value(bv[i]);
+			if(val==l_True){
+				known_one |= ((uint64_t)1)<<i;
+			}else if (val==l_False){
+				known_zero |= ((uint64_t)1)<<i;
+			}
+		}
+		return !(known_zero & known_one);
+	}
+
+	//Smallest value >= bound (in the low 'width' bits) that agrees with the known bits, if one exists.
+	static bool knownBitsCeil(uint64_t bound, uint64_t known_zero, uint64_t known_one, int width, uint64_t & out){
+		for(int i = width-1;i>=0;i--){
+			uint64_t bit = ((uint64_t)1)<<i;
+			if((known_one & bit) && !(bound & bit)){
+				//keep the prefix above i, raise bit i, and take the smallest possible low bits
+				out = (bound & ~lowBits(i+1)) | bit | (known_one & (bit-1));
+				return true;
+			}else if ((known_zero & bit) && (bound & bit)){
+				//the prefix must be raised above i, at the lowest bit that is zero in the bound and not known to be zero
+				for(int j = i+1;j<width;j++){
+					uint64_t jbit = ((uint64_t)1)<<j;
+					if(!(bound & jbit) && !(known_zero & jbit)){
+						out = (bound & ~lowBits(j+1)) | jbit | (known_one & (jbit-1));
+						return true;
+					}
+				}
+				return false;
+			}
+		}
+		out = bound;
+		return true;
+	}
+
+	//Tighten [under,over] to the nearest values that agree with the given known bits of bvID.
+	//If no value in the range agrees with them, under is left above over, which is then reported as a conflict.
+	//Returns true if either bound changed.
+	bool refineKnownBits(int bvID, uint64_t known_zero, uint64_t known_one, Weight & under, Weight & over){
+		int width = getWidth(bvID);
+		uint64_t mask = lowBits(width);
+		known_zero &= mask;
+		known_one &= mask;
+		if(!(known_zero|known_one)){
+			return false;
+		}
+		uint64_t under_l = getLong(under);
+		uint64_t over_l = getLong(over);
+		uint64_t new_under;
+		uint64_t new_over;
+		if(!knownBitsCeil(under_l, known_zero, known_one, width, new_under)){
+			new_under = mask;
+		}
+		//the largest agreeing value <= over is the complement of the smallest complemented value >= ~over
+		if(knownBitsCeil(mask^over_l, known_one, known_zero, width, new_over)){
+			new_over ^= mask;
+		}else{
+			new_over = 0;
+		}
+		bool changed = false;
+		if(new_under>under_l){
+			under = (Weight) new_under;
+			changed = true;
+		}
+		if(new_over<over_l){
+			over = (Weight) new_over;
+			changed = true;
+		}
+		return changed;
+	}
+
+	//Bits of the sum of aID and bID (modulo 2^64) that are fixed by the known bits of the arguments.
+	bool knownBitsAdd(int aID, int bID, uint64_t & known_zero, uint64_t & known_one){
+		uint64_t a_zero, a_one, b_zero, b_one;
+		if(!getKnownBits(aID, a_zero, a_one) || !getKnownBits(bID, b_zero, b_one)){
+			return false;
+		}
+		//the sum of the largest and smallest possible arguments bounds each carry bit
+		uint64_t possible_zero = ~a_zero + ~b_zero;
+		uint64_t possible_one = a_one + b_one;
+		uint64_t carry_known_zero = ~(possible_zero ^ a_zero ^ b_zero);
+		uint64_t carry_known_one = possible_one ^ a_one ^ b_one;
+		uint64_t known = (a_zero | a_one) & (b_zero | b_one) & (carry_known_zero | carry_known_one);
+		known_zero = ~possible_zero & known;
+		known_one = possible_one & known;
+		return true;
+	}
+
+	//Bits of the product of aID and bID (modulo 2^64) that are fixed by the known bits of the arguments:
+	//the trailing zeros of the arguments add up, and the lowest bits that are known in both arguments
+	//determine the same low bits of the product.
+	bool knownBitsMultiply(int aID, int bID, uint64_t & known_zero, uint64_t & known_one){
+		uint64_t a_zero, a_one, b_zero, b_one;
+		if(!getKnownBits(aID, a_zero, a_one) || !getKnownBits(bID, b_zero, b_one)){
+			return false;
+		}
+		int zeros = trailingOnes(a_zero) + trailingOnes(b_zero);
+		int low = std::min(trailingOnes(a_zero | a_one), trailingOnes(b_zero | b_one));
+		uint64_t product = a_one * b_one;
+		known_zero = lowBits(zeros) | (~product & lowBits(low));
+		known_one = product & lowBits(low);
+		return true;
+	}
+
+	//Explain a bound that was derived from the known bits of bvID: its assigned bits, and its own bounds.
+	void analyzeKnownBitsReason(int bvID, vec<Lit> & conflict){
+		if(isConst(bvID)){
+			return;
+		}
+		vec<Lit> & bv = getBits(bvID);
+		for(int i = 0;i<bv.size();i++){
+			Lit bl = bv[i];
+			if(value(bl)==l_False){
+				conflict.push(toSolver(bl));
+			}else if (value(bl)==l_True){
+				conflict.push(toSolver(~bl));
+			}
+		}
+		addAnalysis(Comparison::geq, bvID, under_approx[bvID]);
+		addAnalysis(Comparison::leq, bvID, over_approx[bvID]);
+	}
+
 	//get the outer solver literals
 	void getLiterals(int bvID, vec<Lit> & lits) {
 		//can this be avoided?
@@ -6698,6 +6927,123 @@ public:
 			lits.push(toSolver(l));
 		}
 	}
+
+	//Known-zero and known-one masks of a bitvector, read off its currently assigned bits.
+	//Returns false if the bitvector is too wide for its bits to be tracked in a 64-bit mask.
+	bool getKnownBits(int bvID, uint64_t & known_zero, uint64_t & known_one){
+		vec<Lit> & bv = bitvectors[bvID];
+		known_zero=0;
+		known_one=0;
+		if(bv.size()>=64)
+			return false;
+		for(int i = 0;i<bv.size();i++){
+			lbool val = value(bv[i]);
+			if(val==l_True){
+				known_one|= ((uint64_t)1)<<i;
+			}else if (val==l_False){
+				known_zero|= ((uint64_t)1)<<i;
+			}
+		}
+		return true;
+	}
+
+	static uint64_t lowBits(int n){
+		return n>=64 ? ~((uint64_t)0) : (((uint64_t)1)<<n)-1;
+	}
+
+	static int countTrailingOnes(uint64_t mask, int width){
+		int n = 0;
+		while(n<width && ((mask>>n)&1))
+			n++;
+		return n;
+	}
+
+	//Returns the mask of bits of (a+b) mod 2^width that are fixed by the known bits of a and b, and sets known_value to those bits.
+	//Each bit of the result depends only on the bits of a and b at or below its own position.
+	static uint64_t knownBitsAdd(uint64_t zero_a, uint64_t one_a, uint64_t zero_b, uint64_t one_b, int width, uint64_t & known_value){
+		uint64_t mask = lowBits(width);
+		uint64_t max_sum = (~zero_a & mask) + (~zero_b & mask);
+		uint64_t min_sum = one_a + one_b;
+		//the carry into a bit is known if it is the same in both the smallest and the largest possible sum
+		uint64_t carry_known_zero = ~(max_sum ^ zero_a ^ zero_b);
+		uint64_t carry_known_one = min_sum ^ one_a ^ one_b;
+		uint64_t known = (zero_a | one_a) & (zero_b | one_b) & (carry_known_zero | carry_known_one) & mask;
+		known_value = max_sum & known;
+		return known;
+	}
+
+	//Returns the mask of bits of (a*b) mod 2^width that are fixed by the known bits of a and b, and sets known_value to those bits.
+	//Each bit of the result depends only on the bits of a and b at or below its own position.
+	static uint64_t knownBitsMultiply(uint64_t zero_a, uint64_t one_a, uint64_t zero_b, uint64_t one_b, int width, uint64_t & known_value){
+		//the product has at least as many trailing zeros as both factors combined
+		int trailing_zeros = std::min(width, countTrailingOnes(zero_a,width) + countTrailingOnes(zero_b,width));
+		//and its low bits are fixed by the same number of known low bits in each factor
+		int known_low = std::min(countTrailingOnes(zero_a | one_a,width), countTrailingOnes(zero_b | one_b,width));
+		uint64_t known = lowBits(std::max(trailing_zeros, known_low));
+		known_value = (one_a * one_b) & lowBits(known_low);
+		return known;
+	}
+
+	//Explain why bit 'bit' of the result of a saturating operation over aID and bID was fixed to 'bit_value' by known bits propagation:
+	//the known bits of both arguments at or below that position, and, for a zero bit, the argument bounds that rule out saturation.
+	void buildKnownBitsReason(int aID, int bID, int bit, bool bit_value, vec<Lit> & reason){
+		for(int i = 0;i<=bit;i++){
+			Lit l = bitvectors[aID][i];
+			if(value(l)!=l_Undef){
+				reason.push(toSolver(value(l)==l_True ? ~l : l));
+			}
+		}
+		if(bID!=aID){
+			for(int i = 0;i<=bit;i++){
+				Lit l = bitvectors[bID][i];
+				if(value(l)!=l_Undef){
+					reason.push(toSolver(value(l)==l_True ? ~l : l));
+				}
+			}
+		}
+		if(!bit_value){
+			//read both bounds before building the first comparison reason, which rewinds the trail
+			Weight over_a = over_approx[aID];
+			Weight over_b = over_approx[bID];
+			buildComparisonReason(Comparison::leq,aID,over_a,reason);
+			if(bID!=aID)
+				buildComparisonReason(Comparison::leq,bID,over_b,reason);
+		}
+	}
+
+	//Assign the bits of bvID that 'op' derived from the known bits of its arguments aID and bID.
+	//If the operation may saturate, only the bits that are known to be one can be assigned, as a saturated result has all of its bits set.
+	bool enforceKnownBits(Operation & op, int bvID, int aID, int bID, uint64_t known, uint64_t known_value, bool may_saturate, vec<Lit> & conflict){
+		if(may_saturate){
+			known &= known_value;
+		}
+		vec<Lit> & bv = bitvectors[bvID];
+		for(int i = 0;i<bv.size() && (known>>i);i++){
+			if(!((known>>i)&1))
+				continue;
+			bool bit_value = (known_value>>i)&1;
+			Lit l = bit_value ? bv[i] : ~bv[i];
+			if(value(l)==l_True){
+				continue;
+			}else if (value(l)==l_False){
+				stats_num_conflicts++;
+				stats_known_bits_conflicts++;
+				if(opt_verb>1){
+					printf("bv known bits conflict %" PRId64 "\n", stats_num_conflicts);
+				}
+				conflict.push(toSolver(l));
+				buildKnownBitsReason(aID,bID,i,bit_value,conflict);
+				return false;
+			}else if (S->value(toSolver(l))==l_Undef){
+				//(if the solver has already assigned this bit, any conflict is caught once the theory sees that assignment)
+				knownbits_causes.growTo(nVars(),-1);
+				knownbits_causes[var(l)]=op.getID();
+				stats_known_bits_propagations++;
+				enqueue(l,knownbits_marker);
+			}
+		}
+		return true;
+	}
 	void buildTrivialClause(vec<Lit> & conflict){
 		for (int i = 0;i<nVars();i++){
 			if(value(i)!=l_Undef){
@@ -6864,7 +7210,7 @@ public:
 		return propagateTheory(conflict,false);
 	}
 	bool propagateTheory(vec<Lit> & conflict, bool force_propagation, bool isSolveCheck=false) {
-		static int realprops = 0;
+		static thread_local int realprops = 0;
 		stats_propagations++;
 
 		if (!force_propagation && !requiresPropagation ) {
@@ -7158,7 +7504,7 @@ public:
 			bvID=eq_bitvectors[bvID];
 		writeBounds(bvID);
 		stats_build_value_reason++;
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 		//printf("reason %d: %d\n",iter,bvID);
 
@@ -7204,7 +7550,7 @@ public:
 			return;
 		}
 		if(opt_write_learnt_clauses && opt_write_bv_analysis){
-			static int n_analysis=0;
+			static thread_local int n_analysis=0;
 			if(++n_analysis==430){
 				int a =1;
 			}
@@ -7477,7 +7823,7 @@ public:
 	}
 
 	void analyze(vec<Lit> & conflict){
-		static int64_t iter = 0;
+		static thread_local int64_t iter = 0;
 		int prev_pos = analysis_trail_pos;
 		while(n_pending_analyses>0){
 
@@ -8713,7 +9059,7 @@ public:
 			l = mkLit(newVar(outerVar, comparisonID,true,decidable));
 
 		}
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if(++iter==29){
 			int a =1;
 		}
@@ -9633,7 +9979,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_ubound_check(int bvID, Weight bound, Var ignore_bit){
 #ifdef DEBUG_BV
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
@@ -9653,7 +9999,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_lbound_check(int bvID, Weight bound, Var ignore_bit){
 #ifdef DEBUG_BV
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
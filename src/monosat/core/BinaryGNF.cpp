@@ -0,0 +1,214 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/BinaryGNF.h"
+#include <cstring>
+#include <unordered_map>
+
+using namespace Monosat;
+using namespace Monosat::BinaryGNF;
+
+bool BinaryGNF::isBinaryFilename(const char * filename) {
+	size_t n = strlen(filename);
+	return n >= 5 && strcmp(filename + n - 5, ".gnfb") == 0;
+}
+
+const std::vector<std::string> & BinaryGNF::keywords() {
+	//Version 1 dictionary. Only append to this list (and bump VERSION); never reorder or remove entries.
+	static const std::vector<std::string> dict = { "p", "cnf", "solve", "edge", "weighted_edge", "edge_bv", "edge_set",
+			"edge_priority", "digraph", "node", "int", "float", "rational", "reach", "reach_backward", "on_path",
+			"distance_leq", "distance_lt", "weighted_distance_leq", "weighted_distance_lt", "weighted_distance_bv_leq",
+			"weighted_distance_bv_lt", "maximum_flow_geq", "maximum_flow_gt", "maximum_flow_bv_geq", "maximum_flow_bv_gt",
+			"mst_weight_leq", "mst_weight_lt", "mst_edge", "acyclic", "forest", "connected_component_count_lt",
+			"graph_assign_edges_to_weight", "bv", "bv_ite", "const", "anon", "symbol", "lazy", "bitblast", "ite", "min",
+			"max", "popcount", "unary", "not", "and", "or", "xor", "nand", "nor", "xnor", "slice", "concat", "+", "-", "*",
+			"/", "<", "<=", ">", ">=", "==", "!=", "amo", "pb", "fsm", "str", "transition", "accepts",
+			"accepts_composition", "generates", "transduces", "f_router", "f_router_net", "priority", "decision",
+			"maximize", "minimize", "lits", "minimize_core", "clear_opt", "dbg_solution" };
+	return dict;
+}
+
+static int keywordIndex(const char * token, size_t len) {
+	static const std::unordered_map<std::string, int> index = []() {
+		std::unordered_map<std::string, int> m;
+		for (int i = 0; i < keywords().size(); i++)
+			m[keywords()[i]] = i;
+		return m;
+	}();
+	auto it = index.find(std::string(token, len));
+	return it == index.end() ? -1 : it->second;
+}
+
+//Parse 'token' as an integer, if it is in canonical form (so that it is reproduced exactly when decoded)
+static bool parseCanonicalInt(const char * token, size_t len, int64_t & val) {
+	size_t i = 0;
+	bool neg = false;
+	if (token[0] == '-') {
+		neg = true;
+		i = 1;
+	}
+	size_t n_digits = len - i;
+	//no leading zeros or "-0"; and at most 18 digits, so that the value cannot overflow
+	if (n_digits == 0 || n_digits > 18 || (token[i] == '0' && (n_digits > 1 || neg)))
+		return false;
+	int64_t v = 0;
+	for (; i < len; i++) {
+		if (token[i] < '0' || token[i] > '9')
+			return false;
+		v = v * 10 + (token[i] - '0');
+	}
+	val = neg ? -v : v;
+	return true;
+}
+
+void Encoder::encodeHeader() {
+	out.push_back((char) TAG_HEADER);
+	out.append("GNFB");
+	writeVarint(VERSION, out);
+}
+
+void Encoder::encodeClause(const int * lits, int n) {
+	out.push_back((char) TAG_CLAUSE);
+	writeVarint(n, out);
+	for (int i = 0; i < n; i++) {
+		int64_t l = lits[i];
+		writeVarint((uint64_t) ((l << 1) ^ (l >> 63)), out);
+	}
+}
+
+void Encoder::encodeLine(const char * line, size_t len) {
+	size_t i = 0;
+	while (i < len && isWhitespace(line[i]))
+		i++;
+	while (len > i && isWhitespace(line[len - 1]))
+		len--;
+	if (i == len)
+		return;
+	if (line[i] == 'c') {
+		//comments (including symbol lines) are stored verbatim
+		out.push_back((char) TAG_COMMENT);
+		writeVarint(len - i, out);
+		out.append(line + i, len - i);
+		return;
+	}
+	token_starts.clear();
+	token_lengths.clear();
+	while (i < len) {
+		size_t start = i;
+		while (i < len && !isWhitespace(line[i]))
+			i++;
+		token_starts.push_back(line + start);
+		token_lengths.push_back(i - start);
+		while (i < len && isWhitespace(line[i]))
+			i++;
+	}
+
+	if (isNumber(*token_starts[0])) {
+		//clause(s), which may (as in DIMACS) be spread over several lines
+		for (int t = 0; t < token_starts.size(); t++) {
+			int64_t lit;
+			if (!parseCanonicalInt(token_starts[t], token_lengths[t], lit) || lit > INT32_MAX || lit < -INT32_MAX)
+				parse_errorf("Bad literal in clause: %.*s", (int) token_lengths[t], token_starts[t]);
+			if (lit == 0) {
+				encodeClause(open_clause.data(), open_clause.size());
+				open_clause.clear();
+			} else {
+				open_clause.push_back((int) lit);
+			}
+		}
+		return;
+	}
+	if (hasOpenClause())
+		parse_errorf("Unterminated clause before: %.*s", (int) (len - (token_starts[0] - line)), token_starts[0]);
+
+	out.push_back((char) TAG_LINE);
+	writeVarint(token_starts.size(), out);
+	for (int t = 0; t < token_starts.size(); t++) {
+		const char * token = token_starts[t];
+		size_t n = token_lengths[t];
+		int64_t val;
+		int k;
+		if (parseCanonicalInt(token, n, val)) {
+			if (val >= 0) {
+				out.push_back((char) TOKEN_UINT);
+				writeVarint(val, out);
+			} else {
+				out.push_back((char) TOKEN_NEGINT);
+				writeVarint((uint64_t) (-(val + 1)), out);
+			}
+		} else if ((k = keywordIndex(token, n)) >= 0) {
+			out.push_back((char) TOKEN_KEYWORD);
+			writeVarint(k, out);
+		} else {
+			out.push_back((char) TOKEN_STRING);
+			writeVarint(n, out);
+			out.append(token, n);
+		}
+	}
+}
+
+int64_t BinaryGNF::convert(StreamBuffer & in, FILE * out, bool binary) {
+	Encoder encoder;
+	vec<int> clause;
+	vec<char> line;
+	int64_t n = 0;
+	if (binary)
+		encoder.encodeHeader();
+	for (;;) {
+		skipWhitespace(in);
+		if (isEof(in))
+			break;
+		n++;
+		if (isRecordTag(*in)) {
+			int tag = readRecord(in, clause, line);
+			if (tag == TAG_HEADER) {
+				continue;
+			} else if (tag == TAG_CLAUSE) {
+				if (binary) {
+					encoder.encodeClause(&clause[0], clause.size());
+				} else {
+					for (int l : clause)
+						fprintf(out, "%d ", l);
+					fprintf(out, "0\n");
+				}
+				continue;
+			}
+		} else {
+			readLine(in, line);
+		}
+		//line is now a 0-terminated line of text GNF
+		if (binary) {
+			encoder.encodeLine(&line[0], strlen(&line[0]));
+		} else {
+			fputs(&line[0], out);
+			if (line.size() < 2 || line[line.size() - 2] != '\n')
+				fputc('\n', out);
+		}
+		if (encoder.out.size() >= buffer_size) {
+			fwrite(encoder.out.data(), 1, encoder.out.size(), out);
+			encoder.out.clear();
+		}
+	}
+	if (encoder.hasOpenClause())
+		parse_errorf("Unterminated clause at end of file");
+	fwrite(encoder.out.data(), 1, encoder.out.size(), out);
+	return n;
+}
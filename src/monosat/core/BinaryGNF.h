@@ -0,0 +1,224 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef BINARYGNF_H_
+#define BINARYGNF_H_
+
+#include "monosat/mtl/Vec.h"
+#include "monosat/utils/ParseUtils.h"
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * Compact binary encoding of the GNF constraint format (see FORMAT.md).
+ *
+ * A binary GNF stream is a sequence of records, each starting with a one byte tag.
+ * The tags are control characters that never begin a line of a text GNF, so binary records and text lines
+ * can be freely mixed in a single stream, and a reader may start at any record boundary
+ * (as the portfolio helpers do when loading constraints appended to a recording).
+ *
+ * Integers are stored as LEB128 varints. Clauses (by far the most common lines) have their own record,
+ * and every other line is stored as a sequence of tokens, with integers packed as varints and common
+ * keywords ('edge', 'bv', 'reach', ...) replaced by their index in a fixed dictionary.
+ */
+namespace BinaryGNF {
+
+//Version 1 is the initial format. Keywords may be appended to the dictionary in later versions, but never removed or reordered.
+static const int VERSION = 1;
+
+enum Tag {
+	TAG_HEADER = 1, //"GNFB", followed by the format version (varint)
+	TAG_CLAUSE = 2, //number of literals (varint), followed by each DIMACS literal (zigzag varint), without the terminating 0
+	TAG_LINE = 3, //any other line: the number of tokens (varint), followed by each token (see TokenKind)
+	TAG_COMMENT = 4, //comment line, stored verbatim: length (varint), followed by the text of the line (excluding the newline)
+};
+
+enum TokenKind {
+	TOKEN_STRING = 0, //length (varint), followed by the characters of the token
+	TOKEN_KEYWORD = 1, //index (varint) into the keyword dictionary
+	TOKEN_UINT = 2, //non-negative integer n (varint)
+	TOKEN_NEGINT = 3, //negative integer n, stored as -(n+1) (varint)
+};
+
+static inline bool isRecordTag(int c) {
+	return c >= TAG_HEADER && c <= TAG_COMMENT;
+}
+
+//True if 'filename' should be written in binary GNF (that is, if it has the extension '.gnfb')
+bool isBinaryFilename(const char * filename);
+
+//The keyword dictionary
+const std::vector<std::string> & keywords();
+
+/**
+ * Converts lines of text GNF into binary records, which are accumulated in 'out' until the caller writes them.
+ */
+class Encoder {
+	//literals of a clause whose terminating 0 has not been seen yet
+	std::vector<int> open_clause;
+	std::vector<const char*> token_starts;
+	std::vector<size_t> token_lengths;
+public:
+	std::string out;
+
+	//Append the header record (which should begin every binary GNF file).
+	void encodeHeader();
+
+	//Append the record(s) for one line of text GNF (excluding its newline). Blank lines are dropped.
+	void encodeLine(const char * line, size_t len);
+
+	//Append a clause record for the given DIMACS literals (excluding the terminating 0).
+	void encodeClause(const int * lits, int n);
+
+	//True if a clause has been started, but not yet terminated with a 0.
+	bool hasOpenClause() const {
+		return open_clause.size() > 0;
+	}
+};
+
+static inline void writeVarint(uint64_t val, std::string & out) {
+	while (val >= 0x80) {
+		out.push_back((char) ((val & 0x7F) | 0x80));
+		val >>= 7;
+	}
+	out.push_back((char) val);
+}
+
+template<class B>
+static uint64_t readVarint(B & in) {
+	uint64_t val = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		int c = *in;
+		if (c == EOF)
+			parse_errorf("Truncated binary GNF record");
+		++in;
+		val |= ((uint64_t) (c & 0x7F)) << shift;
+		if (!(c & 0x80))
+			return val;
+	}
+	parse_errorf("Malformed varint in binary GNF record");
+	return 0;
+}
+
+static inline void appendInt(int64_t val, vec<char> & line) {
+	char buf[24];
+	int n = snprintf(buf, sizeof(buf), "%" PRId64, val);
+	for (int i = 0; i < n; i++)
+		line.push(buf[i]);
+}
+
+/**
+ * Decode the binary record at the current position of 'in' (which must be at a record tag).
+ * Clause records are decoded into 'clause' (as DIMACS literals). All other records are converted back into a
+ * line of text GNF, with a trailing newline and terminating 0, in 'line'.
+ * Returns the record's tag.
+ */
+template<class B>
+static int readRecord(B & in, vec<int> & clause, vec<char> & line) {
+	int tag = *in;
+	++in;
+	switch (tag) {
+		case TAG_HEADER: {
+			if (!eagerMatch(in, "GNFB"))
+				parse_errorf("Bad binary GNF header");
+			uint64_t version = readVarint(in);
+			if (version > VERSION)
+				parse_errorf("Unsupported binary GNF version %d (the newest supported version is %d)", (int) version,
+							 VERSION);
+			return tag;
+		}
+		case TAG_CLAUSE: {
+			clause.clear();
+			uint64_t n = readVarint(in);
+			for (uint64_t i = 0; i < n; i++) {
+				uint64_t z = readVarint(in);
+				clause.push((int) ((z >> 1) ^ -(int64_t) (z & 1)));
+			}
+			return tag;
+		}
+		case TAG_COMMENT: {
+			line.clear();
+			uint64_t n = readVarint(in);
+			for (uint64_t i = 0; i < n; i++) {
+				if (*in == EOF)
+					parse_errorf("Truncated binary GNF record");
+				line.push(*in);
+				++in;
+			}
+			line.push('\n');
+			line.push(0);
+			return tag;
+		}
+		case TAG_LINE: {
+			line.clear();
+			const std::vector<std::string> & dict = keywords();
+			uint64_t n_tokens = readVarint(in);
+			for (uint64_t i = 0; i < n_tokens; i++) {
+				if (i > 0)
+					line.push(' ');
+				int kind = *in;
+				++in;
+				if (kind == TOKEN_STRING) {
+					uint64_t n = readVarint(in);
+					for (uint64_t j = 0; j < n; j++) {
+						if (*in == EOF)
+							parse_errorf("Truncated binary GNF record");
+						line.push(*in);
+						++in;
+					}
+				} else if (kind == TOKEN_KEYWORD) {
+					uint64_t k = readVarint(in);
+					if (k >= dict.size())
+						parse_errorf("Unknown keyword %d in binary GNF record", (int) k);
+					for (char c : dict[k])
+						line.push(c);
+				} else if (kind == TOKEN_UINT) {
+					appendInt((int64_t) readVarint(in), line);
+				} else if (kind == TOKEN_NEGINT) {
+					appendInt(-((int64_t) readVarint(in)) - 1, line);
+				} else {
+					parse_errorf("Bad token in binary GNF record");
+				}
+			}
+			line.push('\n');
+			line.push(0);
+			return tag;
+		}
+		default:
+			parse_errorf("Bad binary GNF record tag %d", tag);
+			return tag;
+	}
+}
+
+/**
+ * Copy a (text or binary) GNF stream to 'out', converting it to binary GNF if 'binary' is set, or to text GNF otherwise.
+ * Returns the number of lines/records converted.
+ */
+int64_t convert(StreamBuffer & in, FILE * out, bool binary);
+}
+}
+
+#endif /* BINARYGNF_H_ */
@@ -0,0 +1,78 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/ClauseExchange.h"
+#include <algorithm>
+
+using namespace Monosat;
+
+ClauseExchange::ClauseExchange(int n_members, int max_clause_size) :
+		heads(n_members, 0), max_size(max_clause_size), done(false), winner(-1) {
+}
+
+void ClauseExchange::publish(int member, const vec<Lit> & clause) {
+	if (clause.size() == 0 || clause.size() > max_size || isFinished())
+		return;
+	std::lock_guard<std::mutex> lock(mutex);
+	pool.emplace_back();
+	SharedClause & c = pool.back();
+	c.member = member;
+	c.lits.reserve(clause.size());
+	for (Lit l : clause)
+		c.lits.push_back(l);
+	//a member never reads its own clauses, so it can skip past them immediately.
+	if (heads[member] == pool_start + pool.size() - 1)
+		heads[member]++;
+}
+
+int ClauseExchange::collect(int member, vec<vec<Lit>> & clauses_out) {
+	std::lock_guard<std::mutex> lock(mutex);
+	int n = 0;
+	uint64_t end = pool_start + pool.size();
+	for (uint64_t i = heads[member]; i < end; i++) {
+		SharedClause & c = pool[i - pool_start];
+		if (c.member == member)
+			continue;
+		clauses_out.push();
+		vec<Lit> & out = clauses_out.last();
+		for (Lit l : c.lits)
+			out.push(l);
+		n++;
+	}
+	heads[member] = end;
+
+	//discard clauses that every member has now seen
+	uint64_t min_head = *std::min_element(heads.begin(), heads.end());
+	while (pool_start < min_head) {
+		pool.pop_front();
+		pool_start++;
+	}
+	return n;
+}
+
+bool ClauseExchange::finish(int member) {
+	int expected = -1;
+	if (winner.compare_exchange_strong(expected, member)) {
+		done = true;
+		return true;
+	}
+	return false;
+}
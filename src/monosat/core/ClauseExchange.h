@@ -0,0 +1,103 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef CLAUSEEXCHANGE_H_
+#define CLAUSEEXCHANGE_H_
+
+#include "monosat/core/SolverTypes.h"
+#include "monosat/mtl/Vec.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * Shared pool of learnt clauses for a portfolio of solvers that are all solving the same instance.
+ * Clauses are stored in the external (input file) variable numbering, so that members whose
+ * internal variable numbering differs can still exchange them.
+ * The exchange also records which member (if any) has finished first, so that the remaining
+ * members can give up.
+ */
+class ClauseExchange {
+	struct SharedClause {
+		int member;
+		std::vector<Lit> lits;
+	};
+	std::mutex mutex;
+	std::deque<SharedClause> pool;
+	//index (counting from the very first published clause) of the first clause in the pool
+	uint64_t pool_start = 0;
+	//index of the next clause to be read by each member
+	std::vector<uint64_t> heads;
+
+	int max_size;
+	std::atomic<bool> done;
+	std::atomic<int> winner;
+public:
+	ClauseExchange(int n_members, int max_clause_size);
+
+	int nMembers() const {
+		return heads.size();
+	}
+
+	/**
+	 * Maximum length of a clause that will be accepted into the pool (0 if sharing is disabled)
+	 */
+	int maxClauseSize() const {
+		return max_size;
+	}
+
+	/**
+	 * Add a clause (in external variable numbering) learnt by 'member' to the pool.
+	 */
+	void publish(int member, const vec<Lit> & clause);
+
+	/**
+	 * Append all clauses published by other members since this member last collected to 'clauses_out'.
+	 * Returns the number of clauses collected.
+	 */
+	int collect(int member, vec<vec<Lit>> & clauses_out);
+
+	/**
+	 * Record that 'member' has a definite answer. Returns true if this member was the first to finish.
+	 */
+	bool finish(int member);
+
+	/**
+	 * True once any member has finished; all other members should stop searching.
+	 */
+	bool isFinished() const {
+		return done.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * The first member to finish, or -1 if no member has finished yet.
+	 */
+	int getWinner() const {
+		return winner;
+	}
+};
+};
+
+#endif /* CLAUSEEXCHANGE_H_ */
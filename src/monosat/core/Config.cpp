@@ -63,10 +63,31 @@ BoolOption Monosat::opt_luby_restart(_cat, "luby", "Use the Luby restart sequenc
 IntOption Monosat::opt_restart_first(_cat, "rfirst", "The base restart interval", 100, IntRange(1, INT32_MAX));
 DoubleOption Monosat::opt_restart_inc(_cat, "rinc", "Restart interval increase factor", 2,
                                       DoubleRange(1, false, HUGE_VAL, false));
+IntOption Monosat::opt_reduce_db(_cat, "reduce-db",
+                                 "Learnt clause deletion policy (0=activity, 1=lbd (as in glucose), 2=tiered (core/tier2/local, by lbd))", 0,
+                                 IntRange(0, 2));
+IntOption Monosat::opt_lbd_core(_cat, "lbd-core",
+                                "Learnt clauses with an lbd at most this are never deleted (reduce-db=1 or 2)", 2,
+                                IntRange(0, INT32_MAX));
+IntOption Monosat::opt_lbd_tier2(_cat, "lbd-tier2",
+                                 "Learnt clauses with an lbd at most this are kept for as long as they take part in conflicts (reduce-db=2)", 6,
+                                 IntRange(0, INT32_MAX));
 DoubleOption Monosat::opt_garbage_frac(_cat, "gc-frac",
                                        "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20,
                                        DoubleRange(0, false, HUGE_VAL, false));
 BoolOption Monosat::opt_pre("MAIN", "pre", "Completely turn on/off any preprocessing.", true);
+BoolOption Monosat::opt_profile(_cat, "profile", "Count calls to, and time spent in, each theory's propagation, solving, reason construction, backtracking and conflict handling (reported by -stats-json)", true);
+IntOption Monosat::opt_portfolio("MAIN", "portfolio",
+                                 "Number of diversified solver instances to run in parallel threads (the first to finish wins; 1 disables portfolio solving)", 1,
+                                 IntRange(1, 1024));
+IntOption Monosat::opt_portfolio_share_size(_cat, "portfolio-share-size",
+                                            "Maximum length of learnt clauses (including theory conflict clauses) to share between portfolio solvers (0 disables sharing)", 8,
+                                            IntRange(0, INT32_MAX));
+IntOption Monosat::opt_record_buffer("MAIN", "record-buffer",
+                                     "Size (in KB) of the buffer that constraints are recorded into (see setOutputFile) before a background thread writes them to the file", 8192,
+                                     IntRange(64, INT32_MAX));
+BoolOption Monosat::opt_circuit_hash(_cat, "circuit-hash",
+                                     "Return the output of an identical, previously built gate when the same gate is built again through the circuit interface (structural hashing), instead of introducing a new variable and clauses", true);
 IntOption Monosat::opt_time(_cat, "verb-time", "Detail level of timing benchmarks (these add some overhead)", 0,
                             IntRange(0, 5));
 
@@ -124,9 +145,11 @@ BoolOption Monosat::opt_theory_decision_round_robin(_cat, "round-robin-theory-or
 
 BoolOption Monosat::opt_parser_immediate_mode(_cat,"immediate-parser","",false);
 BoolOption Monosat::opt_remap_vars(_cat,"remap-vars","Remap variables in the GNF internally in the solver, to minimize space required",true);
+BoolOption Monosat::opt_mmap_input(_cat,"mmap-input","Memory map uncompressed input files and parse them in place, instead of reading them through zlib",true);
 BoolOption Monosat::opt_decide_optimization_lits(_cat_opt,"decide-opt-lits","Allow decisions on literals introduced by optimization constraints",true);
 BoolOption  Monosat::opt_strict_search_optimization(_cat_opt,"strict-search","Use strict (rather than >=/<=) constraints during optimization (be warned, this is not always safe!)",false);
-IntOption  Monosat::opt_optimization_search_type(_cat_opt,"search","0: Use binary search for optimization. 1: Use linear search. 2: Use binary search, but switch to linear search for hard values.", 0, IntRange(0, 2));
+IntOption  Monosat::opt_optimization_search_type(_cat_opt,"search","0: Use binary search for optimization. 1: Use linear search. 2: Use binary search, but switch to linear search for hard values. 3: Use core-guided (OLL) search for pseudo-Boolean objectives, and binary search for bitvectors.", 0, IntRange(0, 3));
+IntOption  Monosat::opt_optimization_probes(_cat_opt,"opt-probes","Number of objective bounds to probe concurrently, each on a separate copy of the constraints, before searching for the optimal value of each objective (0 to disable)", 0, IntRange(0, INT32_MAX));
 DoubleOption Monosat::opt_rnd_optimization_freq(_cat_graph,"search-freq", "",0.5,DoubleRange(0, true, 1, true));
 DoubleOption Monosat::opt_rnd_optimization_restart_freq(_cat_graph,"search-restart-freq", "",0.05,DoubleRange(0, true, 1, true));
 
@@ -160,9 +183,12 @@ StringOption Monosat::opt_maxflow_alg(_cat_graph, "maxflow",
                                       "Select max s-t-flow algorithm (edmondskarp, edmondskarp-adj, edmondskarp-dynamic,dinitz,dinitz-linkcut, kohli-torr)",
                                       "kohli-torr"); //ibfs
 StringOption Monosat::opt_reach_alg(_cat_graph, "reach",
-                                    "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
+                                    "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf,bfs-multi)", "ramal-reps");
 StringOption Monosat::opt_dist_alg(_cat_graph, "dist",
-                                   "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf)", "ramal-reps");
+                                   "Select reachability algorithm (bfs,dfs, dijkstra,ramal-reps,cnf,astar)", "ramal-reps");
+IntOption Monosat::opt_dist_landmarks(_cat_graph, "dist-landmarks",
+                                      "Number of landmarks used to bound A* searches for weighted shortest paths (-dist=astar)",
+                                      8, IntRange(0, INT32_MAX));
 
 StringOption Monosat::opt_con_alg(_cat_graph, "connect",
                                   "Select undirected reachability algorithm (bfs,dfs, dijkstra, thorup,cnf)", "bfs");
@@ -173,6 +199,9 @@ StringOption Monosat::opt_mst_alg(_cat_graph, "mst", "Select minimum spanning tr
 
 StringOption Monosat::opt_allpairs_alg(_cat_graph, "allpairs",
                                        "Select allpairs reachability algorithm (floyd-warshall,dijkstra)", "floyd-warshall");
+IntOption Monosat::opt_allpairs_threads(_cat_graph, "allpairs-threads",
+                                        "Number of threads used by floyd-warshall to update independent blocks of the distance matrix (0 or 1 updates them sequentially)",
+                                        0, IntRange(0, 1024));
 StringOption Monosat::opt_components_alg(_cat_graph, "components",
                                          "Select connected-components algorithm (disjoint-sets, link-cut)", "disjoint-sets");
 StringOption Monosat::opt_cycle_alg(_cat_graph, "cycles",
@@ -400,9 +429,21 @@ BoolOption Monosat::opt_dinics_recursive(_cat_graph, "dinitz-recursive",
 IntOption  Monosat::opt_graph_prop_skip(_cat_graph, "graph-theory-skip",
                                         "Only process every nth graph theory propagation ('1' skips no propagations)",1, IntRange(1,INT32_MAX));
 
+BoolOption Monosat::opt_graph_compact(_cat_graph, "graph-compact",
+                                      "Store graph adjacency lists in a compressed sparse row layout during solving", true);
+
+IntOption  Monosat::opt_graph_prop_threads(_cat_graph, "graph-prop-threads",
+                                        "Number of threads used to update independent graph detectors concurrently during graph theory propagation (0 or 1 updates detectors sequentially)",0, IntRange(0,1024));
+
+IntOption  Monosat::opt_graph_prop_min_detectors(_cat_graph, "graph-prop-min-detectors",
+                                        "Minimum number of detectors requiring an update before they are updated concurrently (if graph-prop-threads>1)",4, IntRange(1,INT32_MAX));
+
 IntOption  Monosat::opt_bv_prop_skip(_cat_bv, "bv-theory-skip",
                                      "Only process every nth bv theory propagation ('1' skips no propagations)",1, IntRange(1,INT32_MAX));
 
+BoolOption Monosat::opt_bv_known_bits(_cat_bv, "bv-known-bits",
+                                      "Track which bits of each bitvector are fixed (by its bit assignments and bounds), and use them to tighten the bounds of additions and multiplications",true);
+
 IntOption  Monosat::opt_fsm_prop_skip(_cat_fsm, "fsm-theory-skip",
                                       "Only process every nth fsm theory propagation ('1' skips no propagations)",1, IntRange(1,INT32_MAX));
 
@@ -419,6 +460,10 @@ BoolOption Monosat::opt_fsm_edge_prop(_cat_fsm, "fsm-edge-prop",
                                       "", true);
 BoolOption Monosat::opt_fsm_as_graph(_cat_fsm, "fsm-as-graph",
                                      "", false);
+BoolOption Monosat::opt_fsm_bit_parallel(_cat_fsm, "fsm-bit-parallel",
+                                         "Simulate all strings of an FSM at once, with word-packed sets of strings per state (for generation, this is used as a filter before the unique-path search)", false);
+BoolOption Monosat::opt_fsm_trie(_cat_fsm, "fsm-trie",
+                                 "Share the acceptance checks of strings with common prefixes, and after each change only recheck the prefixes that it can affect", false);
 BoolOption Monosat::opt_fsm_chokepoint_prop(_cat_fsm, "fsm-chokepoint",
                                             "", true);
 
@@ -452,3 +497,19 @@ ComponentsAlg Monosat::componentsalg = ComponentsAlg::ALG_DISJOINT_SETS;
 MinSpanAlg Monosat::mstalg = MinSpanAlg::ALG_KRUSKAL;
 CycleAlg Monosat::cyclealg= CycleAlg::ALG_PK_CYCLE;
 
+SolverConfig SolverConfig::fromOptions() {
+	SolverConfig config;
+	config.reachalg = Monosat::reachalg;
+	config.distalg = Monosat::distalg;
+	config.undirectedalg = Monosat::undirectedalg;
+	config.allpairsalg = Monosat::allpairsalg;
+	config.mincutalg = Monosat::mincutalg;
+	config.componentsalg = Monosat::componentsalg;
+	config.cyclealg = Monosat::cyclealg;
+	config.mstalg = Monosat::mstalg;
+	config.graph_prop_skip = opt_graph_prop_skip;
+	config.lazy_backtrack = opt_lazy_backtrack;
+	config.lazy_backtrack_decisions = opt_lazy_backtrack_decisions;
+	return config;
+}
+
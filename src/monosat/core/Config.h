@@ -28,6 +28,11 @@ extern BoolOption opt_show_version_and_quit;
 extern IntOption opt_verb;
 extern IntOption opt_verb_optimize;
 extern BoolOption opt_pre;
+extern BoolOption opt_profile;
+extern IntOption opt_portfolio;
+extern IntOption opt_portfolio_share_size;
+extern IntOption opt_record_buffer;
+extern BoolOption opt_circuit_hash;
 extern DoubleOption opt_var_decay;
 extern DoubleOption opt_clause_decay;
 extern DoubleOption opt_theory_decay;
@@ -40,6 +45,9 @@ extern BoolOption opt_luby_restart;
 extern IntOption opt_restart_first;
 extern DoubleOption opt_restart_inc;
 extern DoubleOption opt_garbage_frac;
+extern IntOption opt_reduce_db;
+extern IntOption opt_lbd_core;
+extern IntOption opt_lbd_tier2;
 extern BoolOption opt_restarts;
 extern BoolOption opt_rnd_restart;
 extern BoolOption opt_rnd_theory_restart;
@@ -69,8 +77,10 @@ extern IntOption opt_subsearch;
 
 extern BoolOption opt_parser_immediate_mode;
 extern BoolOption opt_remap_vars;
+extern BoolOption opt_mmap_input;
 extern BoolOption opt_decide_optimization_lits;
 extern IntOption opt_optimization_search_type;
+extern IntOption opt_optimization_probes;
 
 extern IntOption opt_clausify_amo;
 extern BoolOption opt_amo_eager_prop;
@@ -94,8 +104,10 @@ extern StringOption opt_maxflow_alg;
 extern StringOption opt_reach_alg;
 extern StringOption opt_con_alg;
 extern StringOption opt_allpairs_alg;
+extern IntOption opt_allpairs_threads;
 extern StringOption opt_undir_allpairs_alg;
 extern StringOption opt_dist_alg;
+extern IntOption opt_dist_landmarks;
 extern StringOption opt_mst_alg;
 
 extern StringOption opt_components_alg;
@@ -231,7 +243,11 @@ extern BoolOption opt_shortest_path_prune_dist;
 extern BoolOption opt_graph_bv_prop;
 
 extern IntOption opt_graph_prop_skip;
+extern BoolOption opt_graph_compact;
+extern IntOption opt_graph_prop_threads;
+extern IntOption opt_graph_prop_min_detectors;
 extern IntOption opt_bv_prop_skip;
+extern BoolOption opt_bv_known_bits;
 extern IntOption opt_fsm_prop_skip;
 
 extern BoolOption opt_fsm_negate_underapprox;
@@ -240,6 +256,8 @@ extern BoolOption opt_fsm_forced_edge_prop;
 extern BoolOption opt_fsm_chokepoint_prop;
 
 extern BoolOption opt_fsm_as_graph;
+extern BoolOption opt_fsm_bit_parallel;
+extern BoolOption opt_fsm_trie;
 extern IntOption opt_fsm_symmetry_breaking;
 extern BoolOption opt_fsm_track_used_transitions;
 
@@ -257,7 +275,7 @@ extern OptionSet opt_route2;
 
 
 enum class ReachAlg {
-	ALG_SAT, ALG_DFS, ALG_DIJKSTRA, ALG_DISTANCE, ALG_BFS, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED,ALG_RAMAL_REPS_BATCHED2
+	ALG_SAT, ALG_DFS, ALG_DIJKSTRA, ALG_DISTANCE, ALG_BFS, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED,ALG_RAMAL_REPS_BATCHED2, ALG_BFS_MULTI
 };
 
 //For undirected reachability
@@ -308,11 +326,36 @@ enum class ConvexHullAlg {
 extern ConvexHullAlg hullAlg;
 
 enum class DistAlg {
-	ALG_SAT, ALG_DIJKSTRA, ALG_DISTANCE, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED,ALG_RAMAL_REPS_BATCHED2
+	ALG_SAT, ALG_DIJKSTRA, ALG_DISTANCE, ALG_RAMAL_REPS, ALG_RAMAL_REPS_BATCHED,ALG_RAMAL_REPS_BATCHED2, ALG_ASTAR
 };
 
 extern DistAlg distalg;
 
+/**
+ * Settings that are fixed when a solver is constructed, and that are read from the solver (rather than from
+ * the process-wide options above) by the solver and its theories.
+ * This allows several solvers in the same process to run with different settings.
+ */
+struct SolverConfig {
+	ReachAlg reachalg = ReachAlg::ALG_RAMAL_REPS_BATCHED;
+	DistAlg distalg = DistAlg::ALG_RAMAL_REPS_BATCHED;
+	ConnectivityAlg undirectedalg = ConnectivityAlg::ALG_DFS;
+	AllPairsAlg allpairsalg = AllPairsAlg::ALG_DIJKSTRA_ALLPAIRS;
+	MinCutAlg mincutalg = MinCutAlg::ALG_EDMONSKARP;
+	ComponentsAlg componentsalg = ComponentsAlg::ALG_DISJOINT_SETS;
+	CycleAlg cyclealg = CycleAlg::ALG_PK_CYCLE;
+	MinSpanAlg mstalg = MinSpanAlg::ALG_KRUSKAL;
+
+	int graph_prop_skip = 1;
+	bool lazy_backtrack = false;
+	bool lazy_backtrack_decisions = false;
+
+	/**
+	 * Snapshot of the current values of the process-wide options.
+	 */
+	static SolverConfig fromOptions();
+};
+
 extern IntOption opt_time;
 
 static inline double rtime(int level = 1) {
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include "monosat/core/Config.h"
 #include "monosat/utils/ParseUtils.h"
+#include "monosat/core/BinaryGNF.h"
 #include "monosat/core/SolverTypes.h"
 #include "monosat/core/Optimize.h"
 #include "monosat/mtl/Vec.h"
@@ -243,21 +244,7 @@ private:
 	}
 	
 	bool readLine(vec<char> & linebuf, B& in) {
-		linebuf.clear();
-		for (;;) {
-			if (isEof(in))
-				return false;
-			else if (*in == '\n') {
-				linebuf.push(*in);
-				++in;
-				break;
-			} else {
-				linebuf.push(*in);
-				++in;
-			}
-		}
-		linebuf.push(0);
-		return true;
+		return Monosat::readLine(in, linebuf);
 	}
 	int vars = 0;
 	int clauses = 0;
@@ -274,25 +261,45 @@ private:
 		assumptions.clear();
 		bool solve=false;
 		vec<char> linebuf;
+		vec<int> binary_clause;
 		try{
 		while(!solve){
 			skipWhitespace(in);
 			if (*in == EOF)
 				break;
 			line_num++;//this will merge line counts if there are multiple blank lines...
-			//Typically, 99% of lines are either comments or clauses, and so it makes a lot of sense to handle these first, and before reading the whole line into a buffer.
-			if(*in=='-' || (*in >= '0' && *in<='9')){
-				//this is a clause
-				clause_count++;
-				readClause(in, S, lits);
-				S.addClause_(lits);
-				continue;
-			}
-			if(*in=='c'){
-				skipLine(in);
-				continue;//comment
+			if(BinaryGNF::isRecordTag(*in)){
+				//binary GNF record (see BinaryGNF.h); other than clauses, these are converted back into lines of text
+				int tag = BinaryGNF::readRecord(in, binary_clause, linebuf);
+				if(tag==BinaryGNF::TAG_CLAUSE){
+					clause_count++;
+					lits.clear();
+					for(int parsed_lit:binary_clause){
+						if(parsed_lit==0)
+							parse_errorf("Bad literal: 0\n");
+						int var = mapVar(S,abs(parsed_lit) - 1);
+						lits.push((parsed_lit > 0) ? mkLit(var) : ~mkLit(var));
+					}
+					S.addClause_(lits);
+					continue;
+				}else if (tag!=BinaryGNF::TAG_LINE){
+					continue;//header or comment
+				}
+			}else{
+				//Typically, 99% of lines are either comments or clauses, and so it makes a lot of sense to handle these first, and before reading the whole line into a buffer.
+				if(*in=='-' || (*in >= '0' && *in<='9')){
+					//this is a clause
+					clause_count++;
+					readClause(in, S, lits);
+					S.addClause_(lits);
+					continue;
+				}
+				if(*in=='c'){
+					skipLine(in);
+					continue;//comment
+				}
+				readLine(linebuf, in);
 			}
-			readLine(linebuf, in);
 			char * b = linebuf.begin();
 			if (match(b,"solve")){
 				int parsed_lit, var;
@@ -457,6 +464,8 @@ private:
 				else if (*in == 'c'){
 					skipLine(in);
 					//continue
+				}else if (*in == BinaryGNF::TAG_COMMENT){
+					BinaryGNF::readRecord(in, binary_clause, linebuf);
 				}else{
 					break;
 				}
@@ -23,152 +23,31 @@
 #ifndef OPTIMIZE_CPP_
 #define OPTIMIZE_CPP_
 #include "monosat/core/Optimize.h"
-#include <csignal>
-#include <sys/resource.h>
+#include "monosat/core/Portfolio.h"
+#include <atomic>
 #include <stdexcept>
 #include <cstdarg>
 #include <string>
 #include <cstdint>
 #include <limits>
+#include <unordered_map>
 namespace Monosat{
 
 namespace Optimization{
-static int64_t time_limit=-1;
-static int64_t memory_limit=-1;
-
-static bool has_system_time_limit=false;
-static rlim_t system_time_limit;
-static bool has_system_mem_limit=false;
-static rlim_t system_mem_limit;
-
-static Solver * solver;
-
-#ifdef __APPLE__
-using sighandler_t = sig_t; //sighandler_t is a gnu extension
-#endif
-static sighandler_t system_sigxcpu_handler  = nullptr; //void (*system_sigxcpu_handler)(int) is also an option
-
-//static initializer, following http://stackoverflow.com/a/1681655
-namespace {
-struct initializer {
-	initializer() {
-		system_sigxcpu_handler=nullptr;
-		time_limit=-1;
-		memory_limit=-1;
-		has_system_time_limit=false;
-		has_system_mem_limit=false;
-	}
-
-	~initializer() {
-		solver =nullptr;
-	}
-};
-static initializer i;
-}
-void disableResourceLimits(Solver * S);
-static void SIGNAL_HANDLER_api(int signum) {
-	if(solver){
-		fprintf(stderr,"Monosat resource limit reached\n");
-		Solver * s = solver;
-		disableResourceLimits(s);
-		s->interrupt();
-	}
-}
-
-
-void enableResourceLimits(Solver * S){
-	if(!solver){
-		assert(solver==nullptr);
-		solver=S;
-
-		struct rusage ru;
-		getrusage(RUSAGE_SELF, &ru);
-		time_t cur_time = ru.ru_utime.tv_sec;
-
-		rlimit rl;
-		getrlimit(RLIMIT_CPU, &rl);
-		time_limit = opt_limit_optimization_time;
-		if(!has_system_time_limit){
-			has_system_time_limit=true;
-			system_time_limit=rl.rlim_cur;
-		}
-
-		if (time_limit < INT32_MAX && time_limit>=0) {
-			assert(cur_time>=0);
-			int64_t local_time_limit = 	 time_limit+cur_time;//make this a relative time limit
-			if (rl.rlim_max == RLIM_INFINITY || (rlim_t) local_time_limit < rl.rlim_max) {
-				rl.rlim_cur = local_time_limit;
-				if (setrlimit(RLIMIT_CPU, &rl) == -1)
-					fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-			}
-		}else{
-			rl.rlim_cur = rl.rlim_max;
-			if (setrlimit(RLIMIT_CPU, &rl) == -1)
-				fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-		}
-
-		getrlimit(RLIMIT_AS, &rl);
-		if(!has_system_mem_limit){
-			has_system_mem_limit=true;
-			system_mem_limit=rl.rlim_cur;
-		}
-		// Set limit on virtual memory:
-		if (memory_limit < INT32_MAX && memory_limit>=0) {
-			rlim_t new_mem_lim = (rlim_t) memory_limit * 1024 * 1024; //Is this safe?
-
-			if (rl.rlim_max == RLIM_INFINITY || new_mem_lim < rl.rlim_max) {
-				rl.rlim_cur = new_mem_lim;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}else{
-				rl.rlim_cur = rl.rlim_max;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}
-		}
-		auto old_sigxcpu = signal(SIGXCPU, SIGNAL_HANDLER_api);
-		if(old_sigxcpu != SIGNAL_HANDLER_api){
-			system_sigxcpu_handler = old_sigxcpu;//store this value for later
-		}
+//Apply the optimization time limit (-opt-time-limit) to a single solve call, on top of any deadline that S already has.
+//Returns S's previous deadline, which disableResourceLimits restores.
+static double enableResourceLimits(Solver * S){
+	double prev_deadline = S->getDeadline();
+	if(opt_limit_optimization_time>=0){
+		double deadline = monotonicTime() + opt_limit_optimization_time;
+		if(prev_deadline<0 || deadline<prev_deadline)
+			S->setDeadline(deadline);
 	}
+	return prev_deadline;
 }
 
-void disableResourceLimits(Solver * S){
-	if(solver){
-
-		solver=nullptr;
-		rlimit rl;
-		getrlimit(RLIMIT_CPU, &rl);
-		if(has_system_time_limit){
-			has_system_time_limit=false;
-			if (rl.rlim_max == RLIM_INFINITY || (rlim_t)system_time_limit < rl.rlim_max) {
-				rl.rlim_cur = system_time_limit;
-				if (setrlimit(RLIMIT_CPU, &rl) == -1)
-					fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-			}else{
-				rl.rlim_cur = rl.rlim_max;
-				if (setrlimit(RLIMIT_CPU, &rl) == -1)
-					fprintf(stderr,"WARNING! Could not set resource limit: CPU-time.\n");
-			}
-		}
-		getrlimit(RLIMIT_AS, &rl);
-		if(has_system_mem_limit){
-			has_system_mem_limit=false;
-			if (rl.rlim_max == RLIM_INFINITY || system_mem_limit < rl.rlim_max) {
-				rl.rlim_cur = system_mem_limit;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}else{
-				rl.rlim_cur = rl.rlim_max;
-				if (setrlimit(RLIMIT_AS, &rl) == -1)
-					fprintf(stderr, "WARNING! Could not set resource limit: Virtual memory.\n");
-			}
-		}
-		if (system_sigxcpu_handler){
-			signal(SIGXCPU, system_sigxcpu_handler);
-			system_sigxcpu_handler=nullptr;
-		}
-	}
+static void disableResourceLimits(Solver * S, double prev_deadline){
+	S->setDeadline(prev_deadline);
 }
 }
 
@@ -418,9 +297,12 @@ int optimize_linear_pb(Monosat::SimpSolver * S, PB::PBConstraintSolver * pbSolve
 	vec<Lit> assume;
 	for(Lit l:assumes)
 		assume.push(l);
+	//Only variables that predate the bound constraints are recorded (and restored): the constraints' intermediate variables
+	//may be shared with (and constrained further by) later bound constraints, so their recorded values can become inconsistent.
+	int initial_vars = S->nVars();
 	vec<Lit> last_satisfying_assign;
 	if(found_model) {
-		for (Var v = 0; v < S->nVars(); v++) {
+		for (Var v = 0; v < initial_vars; v++) {
 			if (!S->isEliminated(v)) {
 				if (S->value(v) == l_True) {
 					last_satisfying_assign.push(mkLit(v));
@@ -483,7 +365,7 @@ int optimize_linear_pb(Monosat::SimpSolver * S, PB::PBConstraintSolver * pbSolve
 				discarded_pb_constraints.pop();
 			}
 			last_satisfying_assign.clear();
-			for (Var v = 0; v < S->nVars(); v++) {
+			for (Var v = 0; v < initial_vars; v++) {
 				if (!S->isEliminated(v) && v != var(decision_lit)) {
 					if (S->value(v) == l_True) {
 						last_satisfying_assign.push(mkLit(v));
@@ -571,9 +453,12 @@ int optimize_binary_pb(Monosat::SimpSolver * S,  PB::PBConstraintSolver * pbSolv
 	vec<Lit> tmp_clause;
 	for(Lit l:assumes)
 		assume.push(l);
+	//Only variables that predate the bound constraints are recorded (and restored): the constraints' intermediate variables
+	//may be shared with (and constrained further by) later bound constraints, so their recorded values can become inconsistent.
+	int initial_vars = S->nVars();
 	vec<Lit> last_satisfying_assign;
 	if(found_model){
-		for(Var v = 0;v<S->nVars();v++){
+		for(Var v = 0;v<initial_vars;v++){
 			if(!S->isEliminated(v)) {
 				if (S->value(v) == l_True) {
 					last_satisfying_assign.push(mkLit(v));
@@ -630,12 +515,12 @@ int optimize_binary_pb(Monosat::SimpSolver * S,  PB::PBConstraintSolver * pbSolv
 			S->setConfBudget(limit);
 		}
 
-		Optimization::enableResourceLimits(S);
+		double prev_deadline = Optimization::enableResourceLimits(S);
 		bool r;
 
 		lbool res = S->solveLimited(assume,false,false);
 		found_model|=(res==l_True);
-		Optimization::disableResourceLimits(S);
+		Optimization::disableResourceLimits(S,prev_deadline);
 		if (res==l_Undef){
 			hit_cutoff=true;
 			if(opt_verb>0){
@@ -657,7 +542,7 @@ int optimize_binary_pb(Monosat::SimpSolver * S,  PB::PBConstraintSolver * pbSolv
 				discarded_pb_constraints.pop();
 			}
 			last_satisfying_assign.clear();
-			for(Var v = 0;v<S->nVars();v++){
+			for(Var v = 0;v<initial_vars;v++){
 				if(!S->isEliminated(v)   && v != var(decision_lit) ) {
 					if (S->value(v) == l_True) {
 						last_satisfying_assign.push(mkLit(v));
@@ -869,11 +754,11 @@ int64_t optimize_binary_bv(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int6
 			S->setConfBudget(limit);
 		}
 
-		Optimization::enableResourceLimits(S);
+		double prev_deadline = Optimization::enableResourceLimits(S);
 		bool r;
 		lbool res = S->solveLimited(assume,false,false);
 		found_model|=(res==l_True);
-		Optimization::disableResourceLimits(S);
+		Optimization::disableResourceLimits(S,prev_deadline);
 		if (res==l_Undef){
 			hit_cutoff=true;
 			if(opt_verb>0|| opt_verb_optimize>=1){
@@ -1097,7 +982,7 @@ int64_t optimize_binary_restart_bv(Monosat::SimpSolver * S, Monosat::BVTheorySol
 			S->setConfBudget(limit);
 		}
 
-		Optimization::enableResourceLimits(S);
+		double prev_deadline = Optimization::enableResourceLimits(S);
 
 		lbool r=l_Undef;
 		if(!used_suggested_midpoint && ( (invert && (mid_point==max_val+1)) || (!invert && mid_point == max_val-1))){
@@ -1110,7 +995,7 @@ int64_t optimize_binary_restart_bv(Monosat::SimpSolver * S, Monosat::BVTheorySol
 		}
 
 		found_model|=(r==l_True);
-		Optimization::disableResourceLimits(S);
+		Optimization::disableResourceLimits(S,prev_deadline);
 
 
 		assume.pop();
@@ -1273,19 +1158,347 @@ void copyModel(SimpSolver & S, vec<Lit> & dest){
 	}
 }
 
+//Core-guided (OLL) optimization of a weighted sum of literals.
+//Each objective literal starts out as a soft assumption that it does not contribute to the objective.
+//Each unsat core raises the lower bound on the objective by the smallest weight in the core, and is relaxed by a new soft
+//assumption that at most one of the core's assumptions is violated. That assumption is in turn loosened (to at most two, three, ...)
+//each time it appears in a later core. The first model found is optimal.
+int optimize_core_guided_pb(Monosat::SimpSolver * S,  PB::PBConstraintSolver * pbSolver, bool invert, const vec<Lit> & assumes,const Objective & o,  bool & hit_cutoff, int64_t & n_solves, bool & found_model){
+	hit_cutoff=false;
+	struct Soft{
+		Lit assumption;
+		int weight;
+		int relaxation;//index of the relaxed core that this assumption bounds, or -1 if it is an objective literal
+		int bound;
+	};
+	vec<Soft> softs;
+	std::unordered_map<int,int> soft_index;//from assumption literals to their index in softs
+	vec<vec<Lit>> relaxed_cores;//the violated assumption literals of each relaxed core
+	vec<Lit> created;//conditional constraints created during the search, which are disabled before returning
+	vec<int> ones;
+
+	auto addSoft = [&](Lit assumption, int weight, int relaxation, int bound){
+		auto it = soft_index.find(toInt(assumption));
+		if(it!=soft_index.end()){
+			softs[it->second].weight+=weight;
+		}else{
+			soft_index[toInt(assumption)]=softs.size();
+			softs.push({assumption,weight,relaxation,bound});
+		}
+	};
+	auto relax = [&](int relaxation, int bound, int weight){
+		vec<Lit> & violated = relaxed_cores[relaxation];
+		ones.clear();
+		ones.growTo(violated.size(),1);
+		Lit d = pbSolver->addConditionalConstr(violated, ones, bound, PB::Ineq::LEQ);
+		created.push(d);
+		addSoft(d,weight,relaxation,bound);
+	};
+
+	for(int i = 0;i<o.pb_lits.size();i++){
+		Lit l = o.pb_lits[i];
+		if(l==lit_Undef)
+			continue;
+		int weight = i<o.pb_weights.size() ? o.pb_weights[i] : 1;
+		//the objective is charged the literal's weight if it is true (when minimizing) or false (when maximizing)
+		Lit good = invert ? l : ~l;
+		if(weight<0){
+			good=~good;
+			weight=-weight;
+		}
+		if(weight>0)
+			addSoft(good,weight,-1,0);
+	}
+
+	vec<Lit> last_satisfying_assign;
+	if(found_model)
+		copyModel(*S,last_satisfying_assign);
+	int initial_vars = S->nVars();
+
+	int64_t lower_bound=0;
+	bool solved=false;
+	vec<Lit> assume;
+	vec<int> core;
+	vec<std::pair<int,int>> loosen;
+	while(!hit_cutoff){
+		assume.clear();
+		for(Lit l:assumes)
+			assume.push(l);
+		for(Soft & s:softs){
+			if(s.weight>0)
+				assume.push(s.assumption);
+		}
+		n_solves++;
+		{
+			int64_t conflict_limit = S->getConflictBudget();
+			if(conflict_limit<0)
+				conflict_limit=INT32_MAX;
+			int64_t opt_lim = opt_limit_optimization_conflicts;
+			if(opt_lim<=0)
+				opt_lim=INT32_MAX;
+			int64_t limit = std::min(opt_lim,conflict_limit);
+			if(limit>= INT32_MAX){
+				limit=-1;//disable limit.
+			}
+			S->setConfBudget(limit);
+		}
+		double prev_deadline = Optimization::enableResourceLimits(S);
+		lbool res = S->solveLimited(assume,false,false);
+		Optimization::disableResourceLimits(S,prev_deadline);
+		if (res==l_Undef){
+			hit_cutoff=true;
+			if(opt_verb>0){
+				printf("\nBudget exceeded during optimization, quiting early (model might not be optimal!)\n");
+			}
+			break;
+		}else if(res==l_True){
+			for(Lit l:assume){
+				if(S->value(l)!=l_True){
+					throw std::runtime_error("Error in optimization (model is inconsistent with assumptions)");
+				}
+			}
+			solved=true;
+			found_model=true;
+			break;
+		}
+		core.clear();
+		for(Lit l:S->conflict){
+			auto it = soft_index.find(toInt(~l));
+			if(it!=soft_index.end() && softs[it->second].weight>0)
+				core.push(it->second);
+		}
+		if(core.size()==0){
+			//the constraints are unsatisfiable independently of the objective
+			break;
+		}
+		int min_weight = softs[core[0]].weight;
+		for(int i:core)
+			min_weight = std::min(min_weight,softs[i].weight);
+		lower_bound+=min_weight;
+		if(opt_verb_optimize>=2){
+			printf("Found core of size %d, lower bound is now %" PRId64 "\n",core.size(),lower_bound);
+		}
+		relaxed_cores.push();
+		loosen.clear();
+		for(int i:core){
+			Soft & s = softs[i];
+			s.weight-=min_weight;
+			relaxed_cores.last().push(~s.assumption);
+			if(s.relaxation>=0 && s.bound+1<relaxed_cores[s.relaxation].size()){
+				loosen.push({s.relaxation,s.bound+1});
+			}
+		}
+		//at least one of the core's assumptions must be violated; charge for any further violations.
+		if(relaxed_cores.last().size()>1){
+			relax(relaxed_cores.size()-1,1,min_weight);
+		}
+		for(auto & p:loosen){
+			relax(p.first,p.second,min_weight);
+		}
+	}
+
+	if(solved){
+		//only variables that predate the relaxation constraints are restored; the rest (including the constraints' own
+		//intermediate variables) may take different values once those constraints are disabled.
+		last_satisfying_assign.clear();
+		for(Var v = 0;v<initial_vars;v++){
+			if(!S->isEliminated(v)) {
+				if (S->value(v) == l_True) {
+					last_satisfying_assign.push(mkLit(v));
+				} else if (S->value(v) == l_False) {
+					last_satisfying_assign.push(mkLit(v, true));
+				}
+			}
+		}
+	}
+	int value = evalPB(*S, o, !invert);
+	S->cancelUntil(0);
+	vec<Lit> tmp_clause;
+	for(Lit d:created){
+		tmp_clause.clear();
+		tmp_clause.push(~d);
+		S->addClauseSafely(tmp_clause);
+	}
+	if(found_model){
+		//restore the best model (without the now disabled relaxation constraints)
+		if(!S->solve(last_satisfying_assign,false,false)){
+			throw std::runtime_error("Error in optimization (instance has become unsat)");
+		}
+		int over = evalPB(*S, o, !invert);
+		if(solved && over!=value){
+			throw std::runtime_error("Error in optimization (minimum values are inconsistent with model)");
+		}
+		value=over;
+	}
+	return value;
+}
+
+//The value of objective o in S's current assignment (if 'worst' is true), or the best value it could take given that assignment.
+static int64_t objectiveValue(SimpSolver & S, const Objective & o, bool worst, bool level0=false){
+	if(o.isBV()){
+		return getApprox((Monosat::BVTheorySolver<int64_t> *) S.getBVTheory(),o.bvID,worst!=o.maximize,level0);
+	}else{
+		return evalPB(S,o,worst!=o.maximize,level0);
+	}
+}
+
+//A literal that, if assigned true, holds objective o to be no worse than 'bound'.
+static Lit objectiveBound(SimpSolver & S, const Objective & o, int64_t bound){
+	if(o.isBV()){
+		Monosat::BVTheorySolver<int64_t> * bvTheory = (Monosat::BVTheorySolver<int64_t> *) S.getBVTheory();
+		return bvTheory->toSolver(bvTheory->newComparison(o.maximize ? Comparison::geq : Comparison::leq, o.bvID, bound, var_Undef,
+										opt_decide_optimization_lits));
+	}else{
+		return S.getPB()->addConditionalConstr(o.pb_lits, o.pb_weights, bound, o.maximize ? PB::Ineq::GEQ : PB::Ineq::LEQ);
+	}
+}
+
+BoundProber::BoundProber(SimpSolver & S, const std::vector<SimpSolver*> & copies):S(S),copies(copies),cancelled(new std::atomic<bool>[copies.size()]){
+	beginRound();
+}
+
+void BoundProber::beginRound(){
+	for(int i = 0;i<nProbes();i++)
+		cancelled[i]=false;
+}
+
+void BoundProber::cancel(int p){
+	cancelled[p]=true;
+	copies[p]->interrupt();
+}
+
+lbool BoundProber::probe(int p, const vec<Lit> & assumptions, const vec<Objective> & objectives, const vec<int64_t> & bounds, int64_t & value){
+	SimpSolver & H = *copies[p];
+	if(cancelled[p])
+		return l_Undef;
+	H.cancelUntil(0);
+	vec<Lit> assume;
+	for(Lit l:assumptions)
+		assume.push(H.mapLit(S.unmap(l)));
+	Objective o;
+	for(int i = 0;i<objectives.size();i++){
+		//translate the objective into H's numbering
+		o = Objective(objectives[i]);
+		if(o.isBV()){
+			o.bvID = ((Monosat::BVTheorySolver<int64_t> *) H.getBVTheory())->mapBV(((Monosat::BVTheorySolver<int64_t> *) S.getBVTheory())->unmapBV(o.bvID));
+		}else{
+			for(Lit & l:o.pb_lits){
+				if(l!=lit_Undef)
+					l = H.mapLit(S.unmap(l));
+			}
+		}
+		assume.push(objectiveBound(H,o,bounds[i]));
+	}
+	H.setConfBudget(opt_limit_optimization_conflicts>0 ? (int64_t) opt_limit_optimization_conflicts : -1);
+	//probes are held to S's deadline, as well as to the optimization time limit
+	H.setDeadline(S.getDeadline());
+	Optimization::enableResourceLimits(&H);
+	if(cancelled[p])
+		return l_Undef;
+	lbool r = H.solveLimited(assume,false,false);
+	if(r==l_True)
+		value = objectiveValue(H,o,true);
+	return r;
+}
+
+//Narrow the range of values of objective i, by probing several evenly spaced bounds at once (a k-ary search), each on a separate
+//copy of the constraints. Earlier objectives are held to their best values.
+//Returns true if the optimal value was found (stored in 'value'), in which case S is left holding a model with that value.
+//Otherwise, if any probe improved on S's current value, S is left holding a model with the improved value.
+static bool probe_objective(SimpSolver & S, BoundProber & prober, const vec<Lit> & user_assumes, vec<Lit> & assume, const vec<Objective> & objectives, int i,
+							const vec<int64_t> & best_values, bool & ever_solved, int64_t & value, int64_t & n_solves){
+	const Objective & o = objectives[i];
+	bool invert = o.maximize;
+	int dir = invert ? -1 : 1;
+	//every value strictly better than lo is infeasible; hi is the best value known to be feasible, if hi_feasible.
+	int64_t lo = objectiveValue(S,o,false,true);
+	int64_t hi = objectiveValue(S,o,true,!ever_solved);
+	bool hi_feasible = ever_solved;
+	int64_t initial_hi = hi;
+
+	vec<Objective> probe_objectives;
+	for(int j = 0;j<=i;j++)
+		probe_objectives.push(Objective(objectives[j]));
+	int n = prober.nProbes();
+	std::vector<vec<int64_t>> bounds(n);
+	std::vector<lbool> results(n);
+	std::vector<int64_t> values(n);
+	while(lt(lo,hi,invert) || (lo==hi && !hi_feasible)){
+		//the candidate bounds are lo, lo+1, ..., up to hi (excluding hi if it is already known to be feasible)
+		int64_t width = (invert ? lo-hi : hi-lo) + (hi_feasible ? 0 : 1);
+		int k = (int) std::min<int64_t>(n,width);
+		for(int p = 0;p<k;p++){
+			bounds[p].clear();
+			for(int j = 0;j<i;j++)
+				bounds[p].push(best_values[j]);
+			bounds[p].push(lo + dir*((width/k)*p + ((width%k)*p)/k));
+			results[p]=l_Undef;
+		}
+		prober.beginRound();
+		runPortfolio(k,[&](int p){
+			lbool r = prober.probe(p,user_assumes,probe_objectives,bounds[p],values[p]);
+			results[p]=r;
+			int64_t b = bounds[p].last();
+			for(int q = 0;q<k;q++){
+				int64_t other = bounds[q].last();
+				//looser bounds than a satisfiable one are satisfiable too, and tighter bounds than an unsatisfiable one are unsatisfiable
+				if(q!=p && ((r==l_True && gt(other,b,invert)) || (r==l_False && lt(other,b,invert))))
+					prober.cancel(q);
+			}
+		});
+		n_solves+=k;
+		bool progress=false;
+		for(int p = 0;p<k;p++){
+			int64_t b = bounds[p].last();
+			if(results[p]==l_True){
+				progress=true;
+				if(!hi_feasible || lt(values[p],hi,invert)){
+					hi = values[p];
+					hi_feasible=true;
+				}
+			}else if(results[p]==l_False){
+				progress=true;
+				if(geq(b,lo,invert))
+					lo = b+dir;
+			}
+		}
+		if(opt_verb_optimize>=2){
+			printf("Probed %d bounds: %s %" PRId64 " is %s, best possible is %" PRId64 "\n",k, hi_feasible ? "best" : "worst", hi,
+				   hi_feasible ? "feasible" : "unknown", lo);
+		}
+		if(!progress)
+			break;//every probe ran out of budget
+	}
+	if(hi_feasible && lt(hi,lo,invert)){
+		throw std::runtime_error("Error in optimization (probed bounds are inconsistent)");
+	}
+	value = hi;
+	if(hi_feasible && (!ever_solved || lt(hi,initial_hi,invert))){
+		//a copy found a better model than S's; hold S to that value, and solve S to recover a matching model
+		assume.push(objectiveBound(S,o,hi));
+		n_solves++;
+		if(!S.solve(assume)){
+			throw std::runtime_error("Error in optimization (probed value is inconsistent with model)");
+		}
+		ever_solved=true;
+		value = objectiveValue(S,o,true);
+	}
+	return hi_feasible && !lt(lo,value,invert);
+}
+
 void resetDecisionPriority(SimpSolver & S,vec<std::pair<Var, int>> & decision_vars){
 	for(auto p:decision_vars){
 		S.setDecisionPriority(p.first, p.second);
 	}
 	decision_vars.clear();
 }
-lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objective> & objectives,bool do_simp,  bool & found_optimal){
+lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objective> & objectives,bool do_simp,  bool & found_optimal, BoundProber * prober){
 	vec<Lit> best_model;
 	vec<Lit> assume;
 	vec<int64_t> model_vals;
 	for(Lit l:assumes)
 		assume.push(l);
-	static int solve_runs=0;
+	static thread_local int solve_runs=0;
 	found_optimal=true;
 	solve_runs++;
 	if(opt_verb>=1 || opt_verb_optimize>=1){
@@ -1326,6 +1539,14 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
 		if(any_pb && !S.getPB()){
 			throw std::runtime_error("No pb solver created!");
 		}
+		//objective literals are evaluated (and, in core-guided search, assumed) between solves,
+		//so they must not be eliminated by preprocessing
+		for(const Objective & o:objectives){
+			for(Lit l:o.pb_lits){
+				if(l!=lit_Undef && !S.isEliminated(var(l)))
+					S.setFrozen(var(l),true);
+			}
+		}
 
 		bool r;
 		if(opt_decide_objectives_first) {
@@ -1417,6 +1638,15 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
 			int64_t n_solves =  1;
 			bool hit_cutoff=false;
 			for (int i = 0;i<objectives.size() && !hit_cutoff;i++){
+				//narrow the objective's range using concurrent probes first, if possible; if that finds the optimal value, no further search is needed.
+				bool probed=false;
+				int64_t probed_val=0;
+				if(prober && prober->nProbes()>0){
+					vec<int64_t> best_values;
+					for(int j = 0;j<i;j++)
+						best_values.push(objectives[j].maximize ? max_values[j] : min_values[j]);
+					probed = probe_objective(S,*prober,assumes,assume,objectives,i,best_values,ever_solved,probed_val,n_solves);
+				}
 				if(objectives[i].isBV()) {
 					int bvID = objectives[i].bvID;
 
@@ -1424,9 +1654,11 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
 						printf("%s bv%d (%d of %d)\n", objectives[i].maximize ? "Maximizing": "Minimizing", bvID, i + 1, objectives.size());
 					}
 					int64_t val=0;
-					if (opt_optimization_search_type==1) {
+					if (probed) {
+						val = probed_val;
+					} else if (opt_optimization_search_type==1) {
 						val = optimize_linear_bv(&S, bvTheory,objectives[i].maximize, assume, bvID, hit_cutoff, n_solves, ever_solved);
-					} else if (opt_optimization_search_type==0) {
+					} else if (opt_optimization_search_type==0 || opt_optimization_search_type==3) {
 						val = optimize_binary_bv(&S, bvTheory, objectives[i].maximize,assume, bvID, hit_cutoff, n_solves, ever_solved);
 					}else if (opt_optimization_search_type==2) {
 						val = optimize_binary_restart_bv(&S, bvTheory, objectives[i].maximize,assume, bvID, hit_cutoff, n_solves, ever_solved);
@@ -1468,12 +1700,16 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
 						printf("%s pb (%d of %d)\n",objectives[i].maximize ? "Maximizing": "Minimizing", i + 1, objectives.size());
 					}
 					int val=0;
-					if (opt_optimization_search_type==1) {
+					if (probed) {
+						val = probed_val;
+					} else if (opt_optimization_search_type==1) {
 						val = optimize_linear_pb(&S, pbSolver,objectives[i].maximize, assume, objectives[i], hit_cutoff, n_solves, ever_solved);
 					} else if (opt_optimization_search_type==0) {
 						val = optimize_binary_pb(&S, pbSolver,objectives[i].maximize, assume,  objectives[i], hit_cutoff, n_solves, ever_solved);
 					}else if (opt_optimization_search_type==2) {
 						val = optimize_binary_pb(&S, pbSolver,objectives[i].maximize, assume,  objectives[i], hit_cutoff, n_solves, ever_solved);
+					}else if (opt_optimization_search_type==3) {
+						val = optimize_core_guided_pb(&S, pbSolver,objectives[i].maximize, assume,  objectives[i], hit_cutoff, n_solves, ever_solved);
 					}else{
 						throw std::runtime_error("Unknown optimization type");
 					}
@@ -1640,7 +1876,7 @@ lbool optimize_and_solve(SimpSolver & S,const vec<Lit> & assumes,const vec<Objec
 //Returns l_Undef if solve time constraints prevent the assumptions from being reduced to a provably locally minimal unsat core
 lbool minimizeCore(SimpSolver & S,vec<Lit> & assumptions,bool do_simp){
 
-	static int solve_runs=0;
+	static thread_local int solve_runs=0;
 	solve_runs++;
 	if(opt_verb>=1 || opt_verb_optimize>=1){
 		if(solve_runs>1){
@@ -29,7 +29,9 @@
 #include "monosat/core/SolverTypes.h"
 
 #include "monosat/mtl/Vec.h"
-
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace Monosat{
 
@@ -98,7 +100,33 @@ int64_t optimize_linear(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t
 
 int64_t optimize_binary(Monosat::SimpSolver * S, Monosat::BVTheorySolver<int64_t> * bvTheory,const vec<Lit> & assume,int bvID, bool & hit_cutoff, int64_t & n_solves);
 
-lbool optimize_and_solve(Monosat::SimpSolver & S,const vec<Lit> & assume,const vec<Objective> & objectives, bool do_simp, bool & found_optimal);
+//Solves independent copies of S's constraints, in order to probe several bounds of an objective concurrently.
+//Each copy must have been loaded with the same constraints as S, using the same external variable and bitvector numbering
+//(for example, the helper solvers of a portfolio), and must be ready to solve.
+class BoundProber{
+	SimpSolver & S;
+	std::vector<SimpSolver*> copies;
+	std::unique_ptr<std::atomic<bool>[]> cancelled;
+public:
+	BoundProber(SimpSolver & S, const std::vector<SimpSolver*> & copies);
+
+	int nProbes()const{
+		return copies.size();
+	}
+	//Allow every copy to solve again, after some were cancelled.
+	void beginRound();
+
+	//Solve copy 'p' under the given assumptions, with each objective held to be no worse than the corresponding bound.
+	//Assumptions, objectives, and bounds are all given in S's numbering.
+	//If the copy is satisfiable, 'value' is set to the value of the last objective in the copy's model.
+	lbool probe(int p, const vec<Lit> & assumptions, const vec<Objective> & objectives, const vec<int64_t> & bounds, int64_t & value);
+
+	//Stop copy 'p' early (safe to call from any thread); it returns l_Undef until the next round.
+	void cancel(int p);
+};
+
+//If a prober is supplied, each objective's range is first narrowed by probing several bounds concurrently (see -opt-probes).
+lbool optimize_and_solve(Monosat::SimpSolver & S,const vec<Lit> & assume,const vec<Objective> & objectives, bool do_simp, bool & found_optimal, BoundProber * prober=nullptr);
 
 
 //Reduce the given assumptions to a (locally) minimal unsat core, if they are mutually unsat.
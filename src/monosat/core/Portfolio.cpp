@@ -0,0 +1,48 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/Portfolio.h"
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace Monosat;
+
+void Monosat::runPortfolio(int n_members, const std::function<void(int)> & solve) {
+	std::vector<std::exception_ptr> errors(n_members);
+	auto run = [&](int member) {
+		try {
+			solve(member);
+		} catch (...) {
+			errors[member] = std::current_exception();
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int i = 1; i < n_members; i++)
+		threads.emplace_back(run, i);
+	run(0);
+	for (std::thread & t : threads)
+		t.join();
+	for (std::exception_ptr & e : errors) {
+		if (e)
+			std::rethrow_exception(e);
+	}
+}
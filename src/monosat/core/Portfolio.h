@@ -0,0 +1,40 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PORTFOLIO_H_
+#define PORTFOLIO_H_
+
+#include "monosat/core/Solver.h"
+#include "monosat/core/ClauseExchange.h"
+#include <functional>
+
+namespace Monosat {
+
+/**
+ * Call solve(i) for each member i in [0, n_members), each in its own thread (member 0 runs in the calling thread),
+ * and wait for all of them to return. Exceptions thrown by any member are re-thrown in the calling thread.
+ * The members are responsible for calling ClauseExchange::finish() when they find an answer, which causes the
+ * remaining members to give up.
+ */
+void runPortfolio(int n_members, const std::function<void(int)> & solve);
+};
+
+#endif /* PORTFOLIO_H_ */
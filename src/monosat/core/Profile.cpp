@@ -0,0 +1,82 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/Profile.h"
+#include <cstdio>
+
+using namespace Monosat;
+
+void ProfileCounter::writeJSON(std::ostream & out) const {
+	out << "{\"calls\":" << calls << ",\"seconds\":" << seconds() << "}";
+}
+
+void TheoryProfile::writeJSON(std::ostream & out) const {
+	out << "\"propagate\":";
+	propagate.writeJSON(out);
+	out << ",\"solve\":";
+	solve.writeJSON(out);
+	out << ",\"reason\":";
+	reason.writeJSON(out);
+	out << ",\"backtrack\":";
+	backtrack.writeJSON(out);
+	out << ",\"conflict\":";
+	conflict.writeJSON(out);
+}
+
+void Monosat::writeDetectorProfile(std::ostream & out, int detectorID, const std::string & name, const ProfileCounter & propagate,
+		const ProfileCounter & reason) {
+	out << "{\"id\":" << detectorID << ",\"name\":";
+	writeJSONString(out, name);
+	out << ",\"propagate\":";
+	propagate.writeJSON(out);
+	out << ",\"reason\":";
+	reason.writeJSON(out);
+	out << "}";
+}
+
+void Monosat::writeJSONString(std::ostream & out, const std::string & str) {
+	out << '"';
+	for (char c : str) {
+		switch (c) {
+		case '"':
+			out << "\\\"";
+			break;
+		case '\\':
+			out << "\\\\";
+			break;
+		case '\n':
+			out << "\\n";
+			break;
+		case '\t':
+			out << "\\t";
+			break;
+		default:
+			if ((unsigned char) c < 0x20) {
+				char buf[8];
+				snprintf(buf, sizeof(buf), "\\u%04x", (unsigned char) c);
+				out << buf;
+			} else {
+				out << c;
+			}
+		}
+	}
+	out << '"';
+}
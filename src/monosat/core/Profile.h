@@ -0,0 +1,100 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include "monosat/core/Config.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace Monosat {
+
+/**
+ * Number of calls to, and total wall-clock time spent in, one instrumented entry point (see -profile).
+ */
+struct ProfileCounter {
+	uint64_t calls = 0;
+	uint64_t nanoseconds = 0;
+
+	double seconds() const {
+		return nanoseconds / 1e9;
+	}
+
+	void writeJSON(std::ostream & out) const;
+};
+
+/**
+ * Adds the duration of the enclosing scope to a counter.
+ * If profiling is disabled, the clock is never read.
+ */
+class ProfileScope {
+	ProfileCounter * counter;
+	std::chrono::steady_clock::time_point start;
+public:
+	explicit ProfileScope(ProfileCounter & c) :
+			counter(opt_profile ? &c : nullptr) {
+		if (counter)
+			start = std::chrono::steady_clock::now();
+	}
+
+	~ProfileScope() {
+		if (counter) {
+			counter->calls++;
+			counter->nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope & operator=(const ProfileScope &) = delete;
+};
+
+/**
+ * The hot-path entry points of a theory solver (or of one of its detectors) that are profiled.
+ * 'conflict' counts the conflicts reported by the theory, and the time the SAT solver spent learning from them.
+ */
+struct TheoryProfile {
+	ProfileCounter propagate;
+	ProfileCounter solve;
+	ProfileCounter reason;
+	ProfileCounter backtrack;
+	ProfileCounter conflict;
+
+	//Write the counters as the members of a JSON object (without the enclosing braces)
+	void writeJSON(std::ostream & out) const;
+};
+
+/**
+ * Write the counters of one detector of a theory (see Theory::writeProfile) as a JSON object.
+ */
+void writeDetectorProfile(std::ostream & out, int detectorID, const std::string & name, const ProfileCounter & propagate,
+		const ProfileCounter & reason);
+
+/**
+ * Write 'str' as a quoted JSON string.
+ */
+void writeJSONString(std::ostream & out, const std::string & str);
+};
+
+#endif /* PROFILE_H_ */
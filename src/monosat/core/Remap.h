@@ -101,6 +101,10 @@ public:
 			}
 			return internalVar< var_reverse_map.size() && var_reverse_map[internalVar] !=var_Undef;
 		}
+	//True if internalVar has a corresponding variable in the input formula numbering (without mapping it on the fly, unlike unmap()).
+	inline	bool hasExternalVar(Var internalVar){
+			return !remap_vars || hasMappedVar(internalVar);
+		}
 	inline	Var getVarFromExternalVar(Var externalVar){
 		if(!remap_vars){
 					return externalVar;
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include "monosat/mtl/Sort.h"
 #include "monosat/graph/GraphTheory.h"
+#include "monosat/core/Remap.h"
 #include <ctype.h>
 using namespace Monosat;
 #ifndef NDEBUG
@@ -36,15 +37,15 @@ using namespace Monosat;
 // Collected in Config.h
 //=================================================================================================
 // Constructor/Destructor:
-bool Solver::shown_warning=false;
+std::atomic<bool> Solver::shown_warning(false);
 Solver::Solver() :
 
 // Parameters (user settable):
 //
-		verbosity(opt_verb), var_decay(opt_var_decay), clause_decay(opt_clause_decay), theory_decay(opt_var_decay), random_var_freq(
+		config(SolverConfig::fromOptions()), verbosity(opt_verb), var_decay(opt_var_decay), clause_decay(opt_clause_decay), theory_decay(opt_var_decay), random_var_freq(
 		opt_random_var_freq), random_seed(opt_random_seed), luby_restart(opt_luby_restart), ccmin_mode(
 		opt_ccmin_mode), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(
-		opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc)
+		opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc), randomize_theory_order_freq(opt_randomize_theory_order_restart_freq), reduce_db_mode(opt_reduce_db), lbd_core(opt_lbd_core), lbd_tier2(opt_lbd_tier2)
 
 		// Parameters (the rest):
 		//
@@ -422,10 +423,11 @@ void Solver::cancelUntil(int lev) {
 	if (decisionLevel() > lev) {
 
 		for (int i = 0; i < theories.size(); i++) {
-			if(opt_lazy_backtrack  && theories[i]->supportsLazyBacktracking()){
+			if(config.lazy_backtrack  && theories[i]->supportsLazyBacktracking()){
 				//if we _are_ backtracking lazily, then the assumption is that the theory solver will, after backtracking, mostly re-assign the same literals.
 				//so instead, we will backtrack the theory lazily, in the future, if it encounters an apparent conflict (and this backtracking may alter or eliminate that conflict.)
 			}else{
+				ProfileScope scope(theories[i]->profile.backtrack);
 				theories[i]->backtrackUntil(lev);
 			}
 		}
@@ -541,7 +543,10 @@ void Solver::cancelUntil(int lev) {
 				if(lowest_re_enqueue<0 || 	trail_lim[back_lev]  < lowest_re_enqueue){
 					lowest_re_enqueue = trail_lim[back_lev];
 				}
-				theories[theoryID]->backtrackUntil(back_lev);//or back_lev -1?
+				{
+					ProfileScope scope(theories[theoryID]->profile.backtrack);
+					theories[theoryID]->backtrackUntil(back_lev);//or back_lev -1?
+				}
 			}
 
 		}
@@ -551,7 +556,10 @@ void Solver::cancelUntil(int lev) {
                 for(int n = 0;n<getNTheories(var(p));n++) {
                     int theoryID = getTheoryID(p,n);
                     Lit theoryLit = getTheoryLit(p,n);
-					theories[theoryID]->backtrackUntil(decisionLevel());
+					{
+						ProfileScope scope(theories[theoryID]->profile.backtrack);
+						theories[theoryID]->backtrackUntil(decisionLevel());
+					}
 					if (theory_reprop_trail_pos[theoryID] ==-1 &&  q>= theory_init_prop_trail_pos[theoryID] && !theorySatisfied(theories[theoryID])) {
 						needsPropagation(theoryID);
 						//theories[theoryID]->backtrackUntil(level(var(p)));
@@ -824,8 +832,23 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 			assert(!isTheoryCause(confl));
 			Clause& c = ca[confl];
 
-			if (c.learnt())
+			if (c.learnt()) {
 				claBumpActivity(c);
+				if (reduce_db_mode > 0) {
+					c.setUsed(true);
+					if (c.lbd() > lbd_core) {
+						//the clause may have become more useful since it was learnt; if so, move it to a better tier
+						int lbd = computeLBD(c);
+						if (lbd + 1 < (int) c.lbd()) {
+							LearntTier old_tier = c.tier();
+							stats_lbd_updates++;
+							setLearntLBD(c, lbd);
+							if (c.tier() != old_tier)
+								stats_tier_promotions++;
+						}
+					}
+				}
+			}
 
 			for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++) {
 				Lit q = c[j];
@@ -1420,7 +1443,7 @@ CRef Solver::propagate(bool propagate_theories) {
 			}
 			initialPropagate = false;
 		}
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 36) {
 
 			int a = 1;
@@ -1501,18 +1524,49 @@ CRef Solver::propagate(bool propagate_theories) {
 	return confl;
 }
 
+void Solver::writeStatsJSON(std::ostream & out){
+	out << "{\"restarts\":" << starts;
+	out << ",\"conflicts\":" << conflicts;
+	out << ",\"theory_conflicts\":" << stats_theory_conflicts;
+	out << ",\"decisions\":" << decisions;
+	out << ",\"propagations\":" << propagations;
+	out << ",\"learnts\":" << learnts.size();
+	out << ",\"cpu_time\":" << cpuTime();
+	out << ",\"analyze\":";
+	stats_analyze_profile.writeJSON(out);
+	out << ",\"theories\":[";
+	for (int i = 0; i < theories.size(); i++) {
+		if (i > 0)
+			out << ",";
+		out << "{\"index\":" << i << ",\"type\":";
+		writeJSONString(out, theories[i]->getTheoryType());
+		out << ",\"name\":";
+		writeJSONString(out, theories[i]->getName());
+		out << ",";
+		theories[i]->writeProfile(out);
+		out << "}";
+	}
+	out << "]}";
+}
+
 bool Solver::propagateTheorySolver(int theoryID, CRef & confl, vec<Lit> & theory_conflict){
 	double start_t = rtime(1);
 	theory_conflict.clear();
 	//todo: ensure that the bv theory comes first, as otherwise dependent theories may have to be propagated twice...
 
 
-	if (!theories[theoryID]->propagateTheory(theory_conflict)) {
+	bool propagated;
+	{
+		ProfileScope scope(theories[theoryID]->profile.propagate);
+		propagated = theories[theoryID]->propagateTheory(theory_conflict);
+	}
+	if (!propagated) {
 		bool has_conflict=true;
 #ifdef DEBUG_CORE
 		for(Lit l:theory_conflict)
 			assert(value(l)!=l_Undef);
 #endif
+		ProfileScope conflict_scope(theories[theoryID]->profile.conflict);
 		if (has_conflict && !addConflictClause(theory_conflict, confl)) {
 			conflicting_heuristic=theories[theoryID]->getConflictingHeuristic();
 			if(conflicting_heuristic){
@@ -1545,8 +1599,42 @@ struct reduceDB_lt {
 		return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
 	}
 };
+//Orders learnt clauses from least to most useful by lbd, breaking ties by activity
+struct reduceDB_lbd_lt {
+	ClauseAllocator& ca;
+	reduceDB_lbd_lt(ClauseAllocator& ca_) :
+			ca(ca_) {
+	}
+	bool operator ()(CRef x, CRef y) {
+		if (ca[x].size() == 2 || ca[y].size() == 2)
+			return ca[x].size() > 2 && ca[y].size() == 2;
+		if (ca[x].lbd() != ca[y].lbd())
+			return ca[x].lbd() > ca[y].lbd();
+		return ca[x].activity() < ca[y].activity();
+	}
+};
+
+void Solver::setLearntLBD(Clause & c, int lbd) {
+	assert(c.learnt());
+	LearntTier old_tier = c.tier();
+	c.setLBD(lbd);
+	LearntTier tier = LearntTier::LOCAL;
+	if (lbd <= lbd_core) {
+		tier = LearntTier::CORE;
+	} else if (reduce_db_mode == 2 && lbd <= lbd_tier2) {
+		tier = LearntTier::TIER2;
+	}
+	//clauses are only ever promoted here; demotion out of tier2 happens in reduceDB
+	if ((int) tier < (int) old_tier)
+		c.setTier(tier);
+}
+
 void Solver::reduceDB() {
 	int i, j;
+	if (reduce_db_mode > 0) {
+		reduceDB_Tiered();
+		return;
+	}
 	double extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
 
 	sort(learnts, reduceDB_lt(ca));
@@ -1564,6 +1652,51 @@ void Solver::reduceDB() {
 	checkGarbage();
 }
 
+/**
+ * Learnt clause deletion for reduce-db=1 or 2.
+ * Core clauses (lbd <= lbd-core) are never deleted.
+ * In tiered mode, tier2 clauses that have not taken part in a conflict since the last reduction are demoted to
+ * the local tier (and so become candidates for deletion at the next reduction).
+ * Of the remaining clauses, the least useful half (by lbd in mode 1, by activity in mode 2) are deleted,
+ * excluding binary and locked clauses.
+ */
+void Solver::reduceDB_Tiered() {
+	int i, j;
+	if (reduce_db_mode == 1) {
+		sort(learnts, reduceDB_lbd_lt(ca));
+	} else {
+		sort(learnts, reduceDB_lt(ca));
+	}
+	int n_candidates = 0;
+	for (i = 0; i < learnts.size(); i++) {
+		if (ca[learnts[i]].tier() == LearntTier::LOCAL)
+			n_candidates++;
+	}
+	int n_deleted = 0;
+	for (i = j = 0; i < learnts.size(); i++) {
+		Clause& c = ca[learnts[i]];
+		LearntTier tier = c.tier();
+		bool used = c.used();
+		c.setUsed(false);
+		if (tier == LearntTier::CORE) {
+			learnts[j++] = learnts[i];
+		} else if (tier == LearntTier::TIER2) {
+			if (!used) {
+				stats_tier_demotions++;
+				c.setTier(LearntTier::LOCAL);
+			}
+			learnts[j++] = learnts[i];
+		} else if (c.size() > 2 && !locked(c) && n_deleted < n_candidates / 2 && !(reduce_db_mode == 1 && used)) {
+			n_deleted++;
+			stats_removed_clauses++;
+			removeClause(learnts[i]);
+		} else
+			learnts[j++] = learnts[i];
+	}
+	learnts.shrink(i - j);
+	checkGarbage();
+}
+
 void Solver::removeSatisfied(vec<CRef>& cs) {
 	int i, j;
 	for (i = j = 0; i < cs.size(); i++) {
@@ -1583,6 +1716,103 @@ void Solver::rebuildOrderHeap() {
 			vs.push(v);
 	order_heap.build(vs);
 }
+void Solver::diversify(int member) {
+	if (member <= 0)
+		return;
+	random_seed = opt_random_seed + 1000003.0 * member;
+	//alternate between luby and geometric restarts, with a range of restart intervals
+	if (member % 2 == 1)
+		luby_restart = !luby_restart;
+	static const double restart_scale[] = { 1, 0.5, 2, 4 };
+	restart_first = std::max(1, (int) (restart_first * restart_scale[(member / 2) % 4]));
+	if (!luby_restart && restart_inc > 1.5)
+		restart_inc = 1.5;
+	if (member % 3 == 2)
+		phase_saving = 1;
+	if (member >= 4)
+		random_var_freq = std::max(random_var_freq, 0.005 * (member % 4 + 1));
+	//shuffle the order in which theory solvers make decisions
+	if (member % 2 == 0 && randomize_theory_order_freq <= 0)
+		randomize_theory_order_freq = 0.25;
+	rnd_init_act = true;
+	for (Var v = 0; v < nVars(); v++)
+		activity[v] = drand(random_seed) * 0.00001;
+	rebuildOrderHeap();
+}
+
+void Solver::setClauseExchange(ClauseExchange * exchange, int member) {
+	clause_exchange = exchange;
+	exchange_member = member;
+	exchange_import.clear();
+}
+
+void Solver::exportClause(const vec<Lit> & clause) {
+	assert(clause_exchange);
+	if (clause.size() == 0 || clause.size() > clause_exchange->maxClauseSize())
+		return;
+	//Clauses are shared in the input formula's variable numbering, which is the only numbering
+	//that the members of the portfolio are guaranteed to agree on.
+	//Clauses over internal variables (eg, those introduced by theory solvers) are not shared.
+	exchange_clause.clear();
+	for (Lit l : clause) {
+		Var v = var(l);
+		if (varRemap) {
+			if (!varRemap->hasExternalVar(v))
+				return;
+			exchange_clause.push(mkLit(varRemap->unmap(v), sign(l)));
+		} else {
+			exchange_clause.push(l);
+		}
+	}
+	clause_exchange->publish(exchange_member, exchange_clause);
+	stats_shared_exported++;
+}
+
+bool Solver::importClauses() {
+	assert(clause_exchange);
+	assert(decisionLevel() == 0);
+	exchange_import.clear();
+	if (!clause_exchange->collect(exchange_member, exchange_import))
+		return ok;
+	for (vec<Lit> & c : exchange_import) {
+		int i, j;
+		bool satisfied = false;
+		for (i = j = 0; i < c.size(); i++) {
+			Var v = var(c[i]);
+			if (varRemap)
+				v = varRemap->getVarFromExternalVar(v);
+			if (v == var_Undef || v >= nVars() || isEliminated(v)) {
+				//this clause mentions a variable that doesn't exist (or no longer exists) in this solver
+				break;
+			}
+			Lit l = mkLit(v, sign(c[i]));
+			if (value(l) == l_True) {
+				satisfied = true;
+				break;
+			} else if (value(l) == l_Undef) {
+				c[j++] = l;
+			}
+		}
+		if (satisfied || i < c.size())
+			continue;
+		c.shrink(i - j);
+		stats_shared_imported++;
+		if (c.size() == 0) {
+			return ok = false;
+		} else if (c.size() == 1) {
+			uncheckedEnqueue(c[0]);
+		} else {
+			CRef cr = ca.alloc(c, true);
+			if (reduce_db_mode > 0)
+				setLearntLBD(ca[cr], c.size());
+			learnts.push(cr);
+			attachClause(cr);
+			claBumpActivity(ca[cr]);
+		}
+	}
+	return ok;
+}
+
 void Solver::rebuildTheoryOrderHeap() {
 
 	theory_order_heap.clear();
@@ -1901,7 +2131,7 @@ void Solver::addClauseSafely(vec<Lit> & ps) {
 	}
 }
 bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent) {
-	static int nlearnt=0;
+	static thread_local int nlearnt=0;
 	if(++nlearnt== 111){
 		int a=1;
 	}
@@ -1935,6 +2165,9 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 /*	if(any_undef){
 		cancelUntil(0);//this is _not_ a conflict clause.
 	}*/
+	if(clause_exchange){
+		exportClause(ps);
+	}
 	confl_out = CRef_Undef;
 	if (ps.size() == 0) {
 		ok = false;
@@ -2033,6 +2266,8 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 			if (permanent || opt_permanent_theory_conflicts)
 				clauses.push(cr);
 			else {
+				if (reduce_db_mode > 0)
+					setLearntLBD(ca[cr], computeLBD(ps));
 				learnts.push(cr);
 				if (--learntsize_adjust_cnt <= 0) {
 					learntsize_adjust_confl *= learntsize_adjust_inc;
@@ -2099,6 +2334,7 @@ bool Solver::addDelayedClauses(CRef & conflict_out) {
 lbool Solver::search(int nof_conflicts) {
 	assert(ok);
 	int backtrack_level;
+	int learnt_lbd = 0;
 	int conflictC = 0;
 	vec<Lit> learnt_clause;
 	Heuristic* previous_conflict_heuristic=nullptr;
@@ -2106,7 +2342,7 @@ lbool Solver::search(int nof_conflicts) {
 	Heuristic * last_decision_heuristic=nullptr;
 	bool decision_heuristic_changed = false;
 	starts++;
-	static int decision_iter=0;
+	static thread_local int decision_iter=0;
 	bool using_theory_decisions= opt_decide_theories && drand(random_seed) < opt_random_theory_freq;
 	bool using_theory_order_heap= opt_decide_theories && (opt_theory_order_vsids || opt_theory_order_swapping) && drand(random_seed) < opt_random_theory_order_freq;
 
@@ -2119,7 +2355,7 @@ lbool Solver::search(int nof_conflicts) {
 	CRef confl = CRef_Undef;
 	n_theory_decision_rounds+=using_theory_decisions;
 	for (;;) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 33) {//3150 //3144
 			int a = 1;
 		}
@@ -2196,7 +2432,12 @@ lbool Solver::search(int nof_conflicts) {
 			if (decisionLevel() == 0)
 				return l_False;
 			learnt_clause.clear();
-			analyze(confl, learnt_clause, backtrack_level);
+			{
+				ProfileScope scope(stats_analyze_profile);
+				analyze(confl, learnt_clause, backtrack_level);
+			}
+			if (reduce_db_mode > 0)
+				learnt_lbd = computeLBD(learnt_clause);//must be computed before backtracking
 
 			int lowest_conflicting_decision_level=decisionLevel();
 			if(last_decision_heuristic && (!conflicting_heuristic || conflicting_heuristic->getPriority()<last_decision_heuristic->getPriority())){
@@ -2398,10 +2639,15 @@ lbool Solver::search(int nof_conflicts) {
 			//this is now slightly more complicated, if there are multiple lits implied by the super solver in the current decision level:
 			//The learnt clause may not be asserting.
 
+			if(clause_exchange){
+				exportClause(learnt_clause);
+			}
 			if (learnt_clause.size() == 1) {
 				uncheckedEnqueue(learnt_clause[0]);
 			} else {
 				CRef cr = ca.alloc(learnt_clause, true);
+				if (reduce_db_mode > 0)
+					setLearntLBD(ca[cr], learnt_lbd);
 				learnts.push(cr);
 				attachClause(cr);
 				claBumpActivity(ca[cr]);
@@ -2793,7 +3039,13 @@ lbool Solver::search(int nof_conflicts) {
 						for (int i = 0; i < theories.size(); i++) {
 							if (opt_subsearch == 3 && track_min_level < initial_level)
 								continue; //Disable attempting to solve sub-solvers if we've backtracked past the super solver's decision level
-							if (!theories[i]->solveTheory(theory_conflict)) {
+							bool solved;
+							{
+								ProfileScope scope(theories[i]->profile.solve);
+								solved = theories[i]->solveTheory(theory_conflict);
+							}
+							if (!solved) {
+								ProfileScope conflict_scope(theories[i]->profile.conflict);
 								if (!addConflictClause(theory_conflict, confl)) {
 									goto conflict;
 								} else {
@@ -2939,7 +3191,7 @@ lbool Solver::solve_() {
 				theory_conflict_counters.clear();
 				theory_conflict_counters.growTo(all_decision_heuristics.size());
 			}
-			if ( opt_randomize_theory_order_restart_freq > 0 && drand(random_seed)<opt_randomize_theory_order_restart_freq) {
+			if ( randomize_theory_order_freq > 0 && drand(random_seed)<randomize_theory_order_freq) {
 				randomShuffle(random_seed, decision_heuristics);
 				for(int i = 0;i<decision_heuristics.size();i++){
 					decision_heuristics[i]->setHeuristicOrder(i);
@@ -2962,6 +3214,10 @@ lbool Solver::solve_() {
 		}
 
 
+		if(clause_exchange && !importClauses()){
+			status = l_False;
+			break;
+		}
 		status = search(rest_base * restart_first);
 		if (verbosity >= 1) {
 			printf("|r%9d | %7d %8d %8d | %8d %8d %6.0f | %" PRId64 " removed |\n", (int) conflicts,
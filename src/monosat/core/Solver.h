@@ -33,6 +33,8 @@
 #include "monosat/core/Theory.h"
 #include "monosat/core/TheorySolver.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/ClauseExchange.h"
+#include <atomic>
 #include <cinttypes>
 #include <map>
 #include <string>
@@ -51,7 +53,7 @@ class DimacsMap;
 class Solver: public Theory,public TheorySolver {
 public:
 	void * _external_data=nullptr;//convenience pointer for external API.
-    static bool shown_warning;
+    static std::atomic<bool> shown_warning;
 	//fix this...
 	friend class Theory;
 	template<typename Weight> friend class GraphTheorySolver;
@@ -169,7 +171,7 @@ public:
 		theory_order_heap.insert(t);
 		theory_conflict_counters.growTo(all_decision_heuristics.size(),0);
 		first_heuristic_decision_level.growTo(all_decision_heuristics.size(),-1);
-		t->setActivity(opt_randomize_theory_order_restart_freq>0 ? drand(random_seed) * 0.00001 : 0);
+		t->setActivity(randomize_theory_order_freq>0 ? drand(random_seed) * 0.00001 : 0);
 		t->setPriority(0);
 	}
 	void activateHeuristic(Heuristic*h)override{
@@ -300,6 +302,22 @@ public:
 		if(stats_theory_conflict_time>0){
 			printf("Time spent in theory conflicts: %f\n",stats_theory_conflict_time);
 		}
+		if(reduce_db_mode>0){
+			int n_tier[3]={0,0,0};
+			uint64_t lbd_sum=0;
+			for(CRef cr:learnts){
+				const Clause & c = ca[cr];
+				n_tier[(int)c.tier()]++;
+				lbd_sum+=c.lbd();
+			}
+			printf("learnt tiers          : %d core, %d tier2, %d local (%.2f avg lbd)\n", n_tier[(int)LearntTier::CORE],
+				   n_tier[(int)LearntTier::TIER2], n_tier[(int)LearntTier::LOCAL], learnts.size() ? ((double) lbd_sum)/learnts.size() : 0.0);
+			printf("lbd updates           : %" PRIu64 " (%" PRIu64 " promotions, %" PRIu64 " demotions)\n", stats_lbd_updates,
+				   stats_tier_promotions, stats_tier_demotions);
+		}
+		if(clause_exchange){
+			printf("portfolio clauses     : %" PRId64 " exported, %" PRId64 " imported\n", stats_shared_exported, stats_shared_imported);
+		}
 		if(opt_check_solution){
 			printf("Solution double-checking time (disable with -no-check-solution): %f s\n",stats_solution_checking_time);
 		}
@@ -308,6 +326,9 @@ public:
 		}
 	}
 
+	//Write the solver's statistics, and the profiling counters of each of its theories (see -profile), as a JSON object.
+	void writeStatsJSON(std::ostream& write_to);
+
 	void writeTheoryWitness(std::ostream& write_to) override {
 		if (!ok) {
 			write_to << "s UNSATISFIABLE\n";
@@ -464,7 +485,7 @@ public:
 
 	//Lazily construct a reason for a literal propagated from a theory
 	CRef constructReason(Lit p) {
-		static int iterp =0;
+		static thread_local int iterp =0;
 		if(++iterp==45){
 			int a=1;
 		}
@@ -481,8 +502,10 @@ public:
 		theory_reason.clear();
 
 		double start_t = rtime(1);
-
-		t->buildReason(getTheoryLit(p,t), theory_reason, cr);
+		{
+			ProfileScope scope(t->profile.reason);
+			t->buildReason(getTheoryLit(p,t), theory_reason, cr);
+		}
 
 		stats_theory_conflict_time+= (rtime(1)-start_t);
 		assert(theory_reason[0] == p);
@@ -494,7 +517,7 @@ public:
 #endif
 #ifdef DEBUG_SOLVER
 		//assert all the other reasons in this cause are earlier on the trail than p...
-		static vec<bool> marks;
+		static thread_local vec<bool> marks;
 		marks.clear();
 		marks.growTo(nVars());
 		for(int i = 0;i<trail.size() && var(trail[i])!=var(p);i++) {
@@ -664,8 +687,28 @@ public:
 	int64_t getConflictBudget();
 	int64_t getPropagationBudget();
 	void budgetOff();
+	void setTimeBudget(double seconds);   // Give up after this many (wall-clock) seconds from now; <0 removes the deadline. Unlike the other budgets, not cleared by budgetOff().
+	double getDeadline() const {          // The monotonicTime() at which the solver will give up, or -1 if there is no deadline.
+		return deadline;
+	}
+	void setDeadline(double time) {
+		deadline = time;
+	}
+	void setMemBudget(int64_t megabytes); // Give up once the clause database has reserved more than this much memory; <0 removes the limit.
 	void interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
 	void clearInterrupt();     // Clear interrupt indicator flag.
+	bool limitReached();       // True if interrupted, or past the deadline or memory budget (which also interrupts the solver). Cheap enough to poll from theories.
+
+	// Portfolio solving:
+	//
+	void diversify(int member);    // Perturb the search parameters of the 'member'th solver of a portfolio (member 0 is left unchanged).
+	void setClauseExchange(ClauseExchange * exchange, int member); // Share short learnt clauses with the other members of 'exchange' (nullptr disables sharing).
+	ClauseExchange * getClauseExchange(){
+		return clause_exchange;
+	}
+	virtual bool isEliminated(Var v) const{ // True if the variable has been removed by preprocessing (see SimpSolver).
+		return false;
+	}
 
 	// Memory managment:
 	//
@@ -761,6 +804,7 @@ public:
 	// Mode of operation:
 	//
 	bool printed_header = false;
+	SolverConfig config;    // Algorithm selections and theory settings owned by this solver (see Config.h)
 	int verbosity;
 	double var_decay;
 	double clause_decay;
@@ -775,6 +819,10 @@ public:
 
 	int restart_first; // The initial restart limit.                                                                (default 100)
 	double restart_inc; // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+	double randomize_theory_order_freq; // Frequency with which to randomize the theory decision order on restarts.
+	int reduce_db_mode;     // Learnt clause deletion policy (0=activity, 1=lbd, 2=tiered).
+	int lbd_core;           // Learnt clauses with lbd <= lbd_core are never deleted (if reduce_db_mode>0).
+	int lbd_tier2;          // Learnt clauses with lbd <= lbd_tier2 are kept while they are in use (if reduce_db_mode==2).
 	double learntsize_factor; // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
 	double learntsize_inc; // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
 
@@ -784,6 +832,11 @@ public:
 	// Statistics: (read-only member variable)
 	//
 	double stats_solution_checking_time=0;
+	uint64_t stats_lbd_updates=0;
+	uint64_t stats_tier_promotions=0;
+	uint64_t stats_tier_demotions=0;
+	int64_t stats_shared_exported=0;
+	int64_t stats_shared_imported=0;
 	uint64_t solves =0;
 	uint64_t starts=0;
 	uint64_t decisions=0;
@@ -802,6 +855,7 @@ public:
 	uint64_t stats_swapping_conflict_count =0;
 	uint64_t stats_theory_conflicts =0;
 	double stats_theory_prop_time =0;
+	ProfileCounter stats_analyze_profile;//conflict analysis (see -profile)
 	double stats_theory_conflict_time=0;
 
 	uint64_t stats_solver_preempted_decisions=0;
@@ -1003,11 +1057,28 @@ protected:
 	//
 	int64_t conflict_budget;    // -1 means no budget.
 	int64_t propagation_budget; // -1 means no budget.
-	bool asynch_interrupt=false;
+	double deadline=-1;         // monotonicTime() after which to give up; -1 means no deadline.
+	int64_t memory_budget=-1;   // Bytes the clause allocator may reserve; -1 means no budget.
+	std::atomic<bool> asynch_interrupt{false};
+
+	// Portfolio solving:
+	//
+	ClauseExchange * clause_exchange=nullptr;//if non-null, short learnt clauses are shared with the other members of the portfolio
+	int exchange_member=-1;
+	vec<Lit> exchange_clause;
+	vec<vec<Lit>> exchange_import;
+
+	vec<uint64_t> lbd_stamps;//per decision level, used to compute lbds
+	uint64_t lbd_stamp=0;
 
 	// Main internal methods:
 	//
 	void insertVarOrder(Var x);                               // Insert a variable in the decision order priority queue.
+	template<class V>
+	int computeLBD(const V & lits);                           // Number of distinct decision levels among the assigned literals of a clause.
+	void setLearntLBD(Clause & c, int lbd);                   // Set the lbd of a learnt clause, and move it into the corresponding tier.
+	void exportClause(const vec<Lit> & clause);               // Publish a learnt clause to the other members of the portfolio (if it is short enough).
+	bool importClauses();                                     // Add clauses learnt by other members of the portfolio (at level 0). Returns false if the solver becomes unsat.
 	Lit pickBranchLit();                                                      // Return the next decision variable.
 
 public:
@@ -1096,6 +1167,7 @@ protected:
 	lbool search(int nof_conflicts);                                     // Search for a given number of conflicts.
 	lbool solve_();                                           // Main solve method (assumptions given in 'assumptions').
 	void reduceDB();                                                      // Reduce the set of learnt clauses.
+	void reduceDB_Tiered();                                               // Reduce the set of learnt clauses by lbd/tier (reduce-db=1 or 2).
 	void removeSatisfied(vec<CRef>& cs);                           // Shrink 'cs' to contain only non-satisfied clauses.
 	void rebuildOrderHeap();
 	void rebuildTheoryOrderHeap();
@@ -1190,7 +1262,7 @@ private:
 	vec<Heuristic*> swapping_uninvolved_pre_theories;
 	vec<Heuristic*> swapping_uninvolved_post_theories;
 	vec<Heuristic*> swapping_involved_theory_order;
-	bool withinBudget() const;
+	bool withinBudget();
 	bool addConflictClause(vec<Lit> & theory_conflict, CRef & confl_out, bool permanent = false) override;
 
 	bool addDelayedClauses(CRef & conflict);
@@ -1336,6 +1408,26 @@ inline int Solver::level(Var x) const {
 	return vardata[x].level;
 }
 
+template<class V>
+inline int Solver::computeLBD(const V & lits) {
+	lbd_stamps.growTo(decisionLevel() + 1, 0);
+	lbd_stamp++;
+	int lbd = 0;
+	for (int i = 0; i < lits.size(); i++) {
+		Lit l = lits[i];
+		if (value(l) == l_Undef) {
+			//unassigned literals (which can occur in theory conflict clauses) each count as their own block
+			lbd++;
+			continue;
+		}
+		int lev = level(var(l));
+		if (lbd_stamps[lev] != lbd_stamp) {
+			lbd_stamps[lev] = lbd_stamp;
+			lbd++;
+		}
+	}
+	return lbd;
+}
 inline void Solver::insertVarOrder(Var x) {
 	if (!order_heap.inHeap(x) && decision[x])
 		order_heap.insert(x);
@@ -1518,6 +1610,12 @@ inline int64_t Solver::getPropagationBudget() {
 	return propagation_budget>-1? (propagation_budget-propagations) : -1;
 }
 
+inline void Solver::setTimeBudget(double seconds) {
+	deadline = seconds < 0 ? -1 : monotonicTime() + seconds;
+}
+inline void Solver::setMemBudget(int64_t megabytes) {
+	memory_budget = megabytes < 0 ? -1 : megabytes * 1024 * 1024;
+}
 inline void Solver::interrupt() {
 	asynch_interrupt = true;
 }
@@ -1525,10 +1623,19 @@ inline void Solver::clearInterrupt() {
 	asynch_interrupt = false;
 }
 inline void Solver::budgetOff() {
-	conflict_budget = propagation_budget = -1;
+	conflict_budget = propagation_budget = memory_budget = -1;
+}
+inline bool Solver::limitReached() {
+	if (asynch_interrupt)
+		return true;
+	if ((deadline >= 0 && monotonicTime() >= deadline) || (memory_budget >= 0 && (int64_t) ca.bytesReserved() > memory_budget)) {
+		asynch_interrupt = true;
+		return true;
+	}
+	return false;
 }
-inline bool Solver::withinBudget() const {
-	return !asynch_interrupt && (conflict_budget < 0 || conflicts < (uint64_t) conflict_budget)
+inline bool Solver::withinBudget() {
+	return !limitReached() && (!clause_exchange || !clause_exchange->isFinished()) && (conflict_budget < 0 || conflicts < (uint64_t) conflict_budget)
 		   && (propagation_budget < 0 || propagations < (uint64_t) propagation_budget);
 }
 
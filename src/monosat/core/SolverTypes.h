@@ -177,6 +177,13 @@ inline lbool toLbool(int v) {
 class Clause;
 typedef RegionAllocator<uint32_t>::Ref CRef;
 
+//Retention tiers for learnt clauses, used by the tiered learnt clause deletion policy (see opt_reduce_db).
+//Core clauses are never deleted, tier2 clauses are kept as long as they keep taking part in conflicts,
+//and local clauses are deleted by activity.
+enum class LearntTier {
+	CORE = 0, TIER2 = 1, LOCAL = 2
+};
+
 class Clause {
 	struct {
 		unsigned mark :2;
@@ -186,11 +193,19 @@ class Clause {
 		unsigned derived :1;
 		unsigned size :26;
 	} header;
+	//Learnt clauses store both their activity and their literal block distance (lbd) after the literals
+	struct LearntData {
+		unsigned lbd :28;
+		unsigned tier :2;
+		unsigned used :1;
+		unsigned unused :1;
+	};
 	union {
 		Lit lit;
 		float act;
 		uint32_t abs;
 		CRef rel;
+		LearntData learnt_data;
 	} data[0];
 
 	friend class ClauseAllocator;
@@ -209,9 +224,13 @@ class Clause {
 			data[i].lit = ps[i];
 
 		if (header.has_extra) {
-			if (header.learnt)
+			if (header.learnt){
 				data[header.size].act = 0;
-			else
+				data[header.size + 1].learnt_data.lbd = ps.size();
+				data[header.size + 1].learnt_data.tier = (unsigned) LearntTier::LOCAL;
+				data[header.size + 1].learnt_data.used = 0;
+				data[header.size + 1].learnt_data.unused = 0;
+			}else
 				calcAbstraction();
 		}
 	}
@@ -231,6 +250,8 @@ public:
 	//This is NOT safe. Only use this if it is guaranteed that the clause has enough extra allocated space
 	void grow(int i) {
 		assert(i >= 0);
+		if (header.learnt)
+			data[header.size + i + 1] = data[header.size + 1];
 		if (header.has_extra)
 			data[header.size + i] = data[header.size];
 		header.size += i;
@@ -239,6 +260,8 @@ public:
 		assert(i <= size());
 		if (header.has_extra)
 			data[header.size - i] = data[header.size];
+		if (header.learnt)
+			data[header.size - i + 1] = data[header.size + 1];
 		header.size -= i;
 	}
 	void pop() {
@@ -300,6 +323,34 @@ public:
 		return data[header.size].abs;
 	}
 
+	//Literal block distance (the number of distinct decision levels in the clause when it was learnt, or the
+	//lowest such count observed since), as in Glucose.
+	uint32_t lbd() const {
+		assert(header.learnt);
+		return data[header.size + 1].learnt_data.lbd;
+	}
+	void setLBD(uint32_t lbd) {
+		assert(header.learnt);
+		data[header.size + 1].learnt_data.lbd = lbd;
+	}
+	LearntTier tier() const {
+		assert(header.learnt);
+		return (LearntTier) data[header.size + 1].learnt_data.tier;
+	}
+	void setTier(LearntTier tier) {
+		assert(header.learnt);
+		data[header.size + 1].learnt_data.tier = (unsigned) tier;
+	}
+	//True if the clause has taken part in conflict analysis since the last clause database reduction
+	bool used() const {
+		assert(header.learnt);
+		return data[header.size + 1].learnt_data.used;
+	}
+	void setUsed(bool used) {
+		assert(header.learnt);
+		data[header.size + 1].learnt_data.used = used;
+	}
+
 	Lit subsumes(const Clause& other) const;
 	void strengthen(Lit p);
 
@@ -318,8 +369,8 @@ public:
 
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
 class ClauseAllocator: public RegionAllocator<uint32_t> {
-	static int clauseWord32Size(int size, bool has_extra) {
-		return (sizeof(Clause) + (sizeof(Lit) * (size + (int) has_extra))) / sizeof(uint32_t);
+	static int clauseWord32Size(int size, bool has_extra, bool learnt) {
+		return (sizeof(Clause) + (sizeof(Lit) * (size + (int) has_extra + (int) learnt))) / sizeof(uint32_t);
 	}
 public:
 	bool extra_clause_field;
@@ -349,9 +400,10 @@ public:
 	CRef alloc(const Lits& ps, bool learnt = false) {
 		static_assert(sizeof(Lit) == sizeof(uint32_t), "");
 		static_assert(sizeof(float) == sizeof(uint32_t), "");
+		static_assert(sizeof(Clause::LearntData) == sizeof(uint32_t), "");
 		bool use_extra = learnt | extra_clause_field;
 
-		CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra));
+		CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), use_extra, learnt));
 		new (lea(cid)) Clause(ps, use_extra, learnt);
 		return cid;
 	}
@@ -379,7 +431,7 @@ public:
 			return;
 		}
 		Clause& c = operator[](cid);
-		RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+		RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra(), c.learnt()));
 	}
 
 	void reloc(CRef& cr, ClauseAllocator& to) {
@@ -399,8 +451,12 @@ public:
 		// Copy extra data-fields:
 		// (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
 		to[cr].mark(c.mark());
-		if (to[cr].learnt())
+		if (to[cr].learnt()){
 			to[cr].activity() = c.activity();
+			to[cr].setLBD(c.lbd());
+			to[cr].setTier(c.tier());
+			to[cr].setUsed(c.used());
+		}
 		else if (to[cr].has_extra())
 			to[cr].calcAbstraction();
 	}
@@ -28,6 +28,7 @@
 #include "monosat/utils/Options.h"
 #include "monosat/core/SolverTypes.h"
 #include "monosat/core/Heuristic.h"
+#include "monosat/core/Profile.h"
 #include <ostream>
 #include <string>
 namespace Monosat {
@@ -37,6 +38,9 @@ namespace Monosat {
 class Theory : public virtual Heuristic{
 
 public:
+	//Call counts and timings of this theory's hot-path entry points, maintained by the SAT solver (see -profile)
+	TheoryProfile profile;
+
 	~Theory() override {
 	}
 
@@ -115,6 +119,11 @@ public:
 	virtual void writeTheoryWitness(std::ostream& write_to) {
 		//do nothing
 	}
+	//Write this theory's profiling counters as the members of a JSON object (without the enclosing braces).
+	//Theories with detectors also report the counters of each detector.
+	virtual void writeProfile(std::ostream& write_to) {
+		profile.writeJSON(write_to);
+	}
 	virtual void preprocess(){
 
 	}
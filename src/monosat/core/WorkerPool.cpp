@@ -0,0 +1,110 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include "monosat/core/WorkerPool.h"
+
+using namespace Monosat;
+
+WorkerPool::WorkerPool(int n_threads) {
+	for (int i = 1; i < n_threads; i++)
+		threads.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shutdown = true;
+	}
+	work_available.notify_all();
+	for (std::thread & t : threads)
+		t.join();
+}
+
+void WorkerPool::runTasks(const std::function<void(int)> * t, int n) {
+	if (n <= 0)
+		return;//this worker woke up after the batch it was signalled for had already completed
+	int i;
+	while ((i = next_task.fetch_add(1)) < n) {
+		try {
+			(*t)(i);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error)
+				error = std::current_exception();
+		}
+	}
+}
+
+void WorkerPool::workerLoop() {
+	uint64_t seen_generation = 0;
+	while (true) {
+		const std::function<void(int)> * t;
+		int n;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			work_available.wait(lock, [&] {return shutdown || generation != seen_generation;});
+			if (shutdown)
+				return;
+			seen_generation = generation;
+			t = task;
+			n = n_tasks;
+			n_busy++;
+		}
+		runTasks(t, n);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			n_busy--;
+		}
+		work_done.notify_one();
+	}
+}
+
+void WorkerPool::run(int n, const std::function<void(int)> & t) {
+	if (n <= 0)
+		return;
+	if (threads.size() == 0 || n == 1) {
+		for (int i = 0; i < n; i++)
+			t(i);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task = &t;
+		n_tasks = n;
+		next_task = 0;
+		error = nullptr;
+		generation++;
+	}
+	work_available.notify_all();
+	runTasks(&t, n);
+	std::exception_ptr e;
+	{
+		//wait for any workers still running the last of the tasks
+		std::unique_lock<std::mutex> lock(mutex);
+		work_done.wait(lock, [&] {return n_busy == 0;});
+		task = nullptr;
+		n_tasks = 0;
+		e = error;
+		error = nullptr;
+	}
+	if (e)
+		std::rethrow_exception(e);
+}
@@ -0,0 +1,78 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+
+#ifndef WORKERPOOL_H_
+#define WORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * A fixed set of persistent worker threads, used to run many small, independent tasks in parallel
+ * without paying the cost of creating threads each time.
+ */
+class WorkerPool {
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable work_available;
+	std::condition_variable work_done;
+
+	//the current batch of tasks
+	const std::function<void(int)> * task = nullptr;
+	int n_tasks = 0;
+	std::atomic<int> next_task{0};
+	int n_busy = 0;
+	uint64_t generation = 0;
+	bool shutdown = false;
+	std::exception_ptr error;
+
+	void workerLoop();
+	void runTasks(const std::function<void(int)> * t, int n);
+public:
+	/**
+	 * Create a pool that runs tasks on n_threads threads in total (the calling thread of run() counts as one of them).
+	 */
+	explicit WorkerPool(int n_threads);
+	~WorkerPool();
+
+	int nThreads() const {
+		return threads.size() + 1;
+	}
+
+	/**
+	 * Call task(i) for each i in [0, n), distributing the calls across the pool, and wait for them all to complete.
+	 * The order in which tasks are run is unspecified. If any task throws, the first exception is re-thrown here
+	 * (after all tasks have finished).
+	 * run() must not be called concurrently from multiple threads, or from within a task.
+	 */
+	void run(int n, const std::function<void(int)> & task);
+};
+};
+
+#endif /* WORKERPOOL_H_ */
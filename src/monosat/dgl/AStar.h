@@ -0,0 +1,469 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef ASTAR_H_
+#define ASTAR_H_
+
+#include <vector>
+#include <algorithm>
+#include "monosat/dgl/alg/Heap.h"
+#include "Graph.h"
+#include "DynamicGraph.h"
+#include "Distance.h"
+#include "monosat/core/Config.h"
+#include <limits>
+#include <cinttypes>
+#include <cstdio>
+namespace dgl {
+
+/**
+ * Point-to-point shortest paths from a fixed source, using bidirectional A* search with ALT lower bounds
+ * (landmarks and the triangle inequality).
+ *
+ * Unlike Dijkstra, update() doesn't compute the distance to every node. Instead, each distance query searches from the
+ * source towards the queried node only, and the answer is cached until the graph changes. Destinations registered with
+ * addDestination() are resolved (and reported to the status) on update().
+ *
+ * Landmark distances are computed once over all edges, enabled or not, and are only recomputed when nodes or edges are
+ * added or an edge weight decreases; so they remain valid lower bounds as edges are disabled and enabled.
+ * previous() and incomingEdge() are defined for every node on the shortest path to a queried node, which is what the
+ * detectors need to read back a path. If many different nodes are queried between two changes to the graph, this falls
+ * back on a single Dijkstra search, which answers all of them.
+ */
+template<typename Weight = int64_t, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus, bool undirected = false>
+class AStar: public Distance<Weight> {
+	using Distance<Weight>::inf;
+	using Distance<Weight>::unreachable;
+public:
+	Graph & g;
+	Status & status;
+	int reportPolarity;
+	int source;
+
+	int last_modification = -1;
+	int last_addition = 0;
+	int last_edge_inc = 0;
+	int last_edge_dec = 0;
+	int last_history_clear = 0;
+	int history_qhead = 0;
+	//the graph that the landmark distances were computed for
+	int landmark_nodes = -1;
+	int landmark_edges = -1;
+	int landmark_edge_dec = -1;
+
+	//distances and shortest path edges, for the nodes resolved since the graph last changed
+	std::vector<Weight> dist;
+	std::vector<int> prev;
+	std::vector<int> resolved; //the epoch in which each node was last resolved
+	int epoch = 0;
+	int n_point_searches = 0; //point-to-point searches in this epoch
+	int max_point_searches;
+
+	std::vector<int> destinations;
+	std::vector<bool> is_destination;
+
+	int n_landmarks;
+	std::vector<std::vector<Weight>> landmark_from; //distance from each landmark to each node, over all edges
+	std::vector<std::vector<Weight>> landmark_to; //distance from each node to each landmark, over all edges
+
+	//search labels, for the forward (0) and backward (1) directions of the current point-to-point search
+	std::vector<Weight> search_dist[2];
+	std::vector<Weight> search_key[2];
+	std::vector<int> search_edge[2]; //-2 marks a node that the landmarks prove is not on any path
+	std::vector<int> search_mark[2]; //the search in which each node was last labelled
+	int search_id = 0;
+
+	struct KeyCmp {
+		std::vector<Weight> & key;
+		bool operator()(int a, int b) const {
+			return key[a] < key[b];
+		}
+		KeyCmp(std::vector<Weight> & key) :
+				key(key) {
+		}
+	};
+	alg::Heap<KeyCmp> q_forward;
+	alg::Heap<KeyCmp> q_backward;
+	std::vector<int> path;
+
+public:
+	int64_t num_updates = 0;
+	int64_t stats_point_searches = 0;
+	int64_t stats_full_searches = 0;
+	int64_t stats_skipped_updates = 0;
+	int64_t stats_landmark_updates = 0;
+	int64_t stats_settled = 0;
+
+	AStar(int s, Graph & graph, Status & status, int reportPolarity = 0, int maxPointSearches = 16) :
+			g(graph), status(status), reportPolarity(reportPolarity), source(s), max_point_searches(maxPointSearches), n_landmarks(
+					Monosat::opt_dist_landmarks), q_forward(KeyCmp(search_key[0])), q_backward(KeyCmp(search_key[1])) {
+	}
+
+	AStar(int s, Graph & graph, int reportPolarity = 0, int maxPointSearches = 16) :
+			g(graph), status(Distance<Weight>::nullStatus), reportPolarity(reportPolarity), source(s), max_point_searches(
+					maxPointSearches), n_landmarks(Monosat::opt_dist_landmarks), q_forward(KeyCmp(search_key[0])), q_backward(
+					KeyCmp(search_key[1])) {
+	}
+
+	void setSource(int s) override {
+		source = s;
+		last_modification = -1;
+	}
+	int getSource() override {
+		return source;
+	}
+	int numUpdates() const override {
+		return num_updates;
+	}
+	void printStats() override {
+		printf("Updates: %" PRId64 " (%" PRId64 " kept all distances), point searches: %" PRId64 " (%" PRId64 " nodes settled), full searches: %" PRId64 ", landmark updates: %" PRId64 "\n",
+				num_updates, stats_skipped_updates, stats_point_searches, stats_settled, stats_full_searches, stats_landmark_updates);
+	}
+
+	void addDestination(int node) override {
+		if (is_destination.size() <= node)
+			is_destination.resize(node + 1, false);
+		if (!is_destination[node]) {
+			is_destination[node] = true;
+			destinations.push_back(node);
+		}
+	}
+	void removeDestination(int node) override {
+		if (node < is_destination.size() && is_destination[node]) {
+			is_destination[node] = false;
+			destinations.erase(std::find(destinations.begin(), destinations.end(), node));
+		}
+	}
+
+	void update() override {
+		if (last_modification == g.getCurrentHistory())
+			return;
+		sync();
+		for (int u : destinations) {
+			resolve(u);
+			if (reportPolarity <= 0 && dist[u] >= inf()) {
+				status.setReachable(u, false);
+				status.setMininumDistance(u, false, dist[u]);
+			} else if (reportPolarity >= 0 && dist[u] < inf()) {
+				status.setReachable(u, true);
+				status.setMininumDistance(u, true, dist[u]);
+			}
+		}
+		num_updates++;
+	}
+
+	bool connected_unsafe(int t) override {
+		return connected(t);
+	}
+	bool connected_unchecked(int t) override {
+		return connected(t);
+	}
+	bool connected(int t) override {
+		resolve(t);
+		return dist[t] < inf();
+	}
+	Weight & distance(int t) override {
+		resolve(t);
+		if (dist[t] < inf())
+			return dist[t];
+		return this->unreachable();
+	}
+	Weight & distance_unsafe(int t) override {
+		return distance(t);
+	}
+	int incomingEdge(int t) override {
+		resolve(t);
+		return prev[t];
+	}
+	int previous(int t) override {
+		int edgeID = incomingEdge(t);
+		if (edgeID < 0)
+			return -1;
+		return otherEnd(edgeID, t);
+	}
+
+private:
+	inline int otherEnd(int edgeID, int u) {
+		auto & e = g.getEdge(edgeID);
+		return e.from == u ? e.to : e.from;
+	}
+
+	//Bring the resolved distances up to date with the graph. If the only changes since the last call were deletions of
+	//edges that are not on any resolved shortest path, then every resolved distance is still correct; otherwise, start a
+	//new epoch, discarding them.
+	void sync() {
+		if (last_modification == g.getCurrentHistory())
+			return;
+		int n = g.nodes();
+		bool keep = last_modification > 0 && last_addition == g.nAdditions() && last_edge_inc == g.lastEdgeIncrease()
+				&& last_edge_dec == g.lastEdgeDecrease() && last_history_clear == g.nHistoryClears() && dist.size() == n;
+		if (dist.size() != n) {
+			dist.resize(n, inf());
+			prev.resize(n, -1);
+			resolved.resize(n, -1);
+			for (int dir = 0; dir < 2; dir++) {
+				search_dist[dir].resize(n);
+				search_key[dir].resize(n);
+				search_edge[dir].resize(n, -1);
+				search_mark[dir].resize(n, -1);
+			}
+		}
+		if (landmark_nodes != n || landmark_edges != g.edges() || landmark_edge_dec != g.lastEdgeDecrease())
+			computeLandmarks();
+		for (int i = history_qhead; keep && i < g.historySize(); i++) {
+			assert(!g.getChange(i).addition);
+			int edgeID = g.getChange(i).id;
+			auto & e = g.getEdge(edgeID);
+			if ((resolved[e.to] == epoch && prev[e.to] == edgeID) || (undirected && resolved[e.from] == epoch && prev[e.from] == edgeID))
+				keep = false;
+		}
+		if (keep) {
+			stats_skipped_updates++;
+		} else {
+			epoch++;
+			n_point_searches = 0;
+		}
+		last_modification = g.getCurrentHistory();
+		last_addition = g.nAdditions();
+		last_edge_inc = g.lastEdgeIncrease();
+		last_edge_dec = g.lastEdgeDecrease();
+		last_history_clear = g.nHistoryClears();
+		history_qhead = g.historySize();
+	}
+
+	void resolve(int t) {
+		sync();
+		assert(t >= 0 && t < g.nodes());
+		if (resolved[t] == epoch)
+			return;
+		if (t == source) {
+			dist[t] = 0;
+			prev[t] = -1;
+			resolved[t] = epoch;
+		} else if (n_point_searches >= max_point_searches) {
+			fullSearch();
+		} else {
+			pointSearch(t);
+		}
+		assert(resolved[t] == epoch);
+	}
+
+	//Dijkstra's algorithm from root, over either the enabled edges or all of them, and following edges backwards if requested.
+	void searchAll(int root, bool backward, bool enabledOnly, std::vector<Weight> & d, std::vector<int> * pred) {
+		d.clear();
+		d.resize(g.nodes(), inf());
+		if (pred) {
+			pred->clear();
+			pred->resize(g.nodes(), -1);
+		}
+		alg::Heap<KeyCmp> q((KeyCmp(d)));
+		d[root] = 0;
+		q.insert(root);
+		while (q.size()) {
+			int u = q.removeMin();
+			int n = backward ? g.nIncoming(u, undirected) : g.nIncident(u, undirected);
+			for (int i = 0; i < n; i++) {
+				auto & e = backward ? g.incoming(u, i, undirected) : g.incident(u, i, undirected);
+				if (enabledOnly && !g.edgeEnabled(e.id))
+					continue;
+				Weight alt = d[u] + g.getWeight(e.id);
+				if (alt < d[e.node]) {
+					d[e.node] = alt;
+					if (pred)
+						(*pred)[e.node] = e.id;
+					if (!q.inHeap(e.node))
+						q.insert(e.node);
+					else
+						q.decrease(e.node);
+				}
+			}
+		}
+	}
+
+	//Select landmarks by farthest-point selection: start from the node furthest from the source, then repeatedly add
+	//the node furthest from its closest landmark (preferring nodes that no landmark reaches at all).
+	void computeLandmarks() {
+		stats_landmark_updates++;
+		int n = g.nodes();
+		landmark_nodes = n;
+		landmark_edges = g.edges();
+		landmark_edge_dec = g.lastEdgeDecrease();
+		landmark_from.clear();
+		landmark_to.clear();
+		if (n_landmarks <= 0 || n == 0)
+			return;
+		std::vector<Weight> closest;
+		searchAll(source, false, false, closest, nullptr);
+		std::vector<bool> is_landmark(n, false);
+		while (landmark_from.size() < n_landmarks) {
+			int next = -1;
+			for (int u = 0; u < n; u++) {
+				if (is_landmark[u])
+					continue;
+				if (next < 0 || closest[next] < closest[u])
+					next = u;
+			}
+			if (next < 0)
+				break;
+			is_landmark[next] = true;
+			landmark_from.emplace_back();
+			landmark_to.emplace_back();
+			searchAll(next, false, false, landmark_from.back(), nullptr);
+			searchAll(next, true, false, landmark_to.back(), nullptr);
+			for (int u = 0; u < n; u++) {
+				if (landmark_from.back()[u] < closest[u])
+					closest[u] = landmark_from.back()[u];
+			}
+		}
+	}
+
+	//Compute a lower bound on the distance from a to b. Returns false if the landmarks prove that a cannot reach b.
+	bool lowerBound(int a, int b, Weight & bound) {
+		bound = 0;
+		for (int i = 0; i < landmark_from.size(); i++) {
+			std::vector<Weight> & from = landmark_from[i];
+			std::vector<Weight> & to = landmark_to[i];
+			//d(a,b) >= d(L,b) - d(L,a)
+			if (from[a] < inf()) {
+				if (from[b] >= inf())
+					return false;
+				if (bound < from[b] - from[a])
+					bound = from[b] - from[a];
+			}
+			//d(a,b) >= d(a,L) - d(b,L)
+			if (to[b] < inf()) {
+				if (to[a] >= inf())
+					return false;
+				if (bound < to[a] - to[b])
+					bound = to[a] - to[b];
+			}
+		}
+		return true;
+	}
+
+	//Label node u in the given direction, returning false if it cannot be on a path from the source to t.
+	bool label(int dir, int u, int t, const Weight & d, int edgeID) {
+		Weight h;
+		search_mark[dir][u] = search_id;
+		if (!(dir ? lowerBound(source, u, h) : lowerBound(u, t, h))) {
+			search_edge[dir][u] = -2;
+			return false;
+		}
+		search_dist[dir][u] = d;
+		search_key[dir][u] = d + h;
+		search_edge[dir][u] = edgeID;
+		(dir ? q_backward : q_forward).insert(u);
+		return true;
+	}
+
+	//Bidirectional A* search from the source to t, using the symmetric stopping criterion: each direction uses its own
+	//consistent lower bound, and the search stops once either frontier cannot improve on the best path found.
+	void pointSearch(int t) {
+		stats_point_searches++;
+		n_point_searches++;
+		search_id++;
+		q_forward.clear();
+		q_backward.clear();
+		Weight best = inf();
+		int meet = -1;
+		if (label(0, source, t, 0, -1) && label(1, t, t, 0, -1)) {
+			while (q_forward.size() && q_backward.size()) {
+				if (!(search_key[0][q_forward.peekMin()] < best) || !(search_key[1][q_backward.peekMin()] < best))
+					break;
+				int dir = q_forward.size() <= q_backward.size() ? 0 : 1;
+				alg::Heap<KeyCmp> & q = dir ? q_backward : q_forward;
+				int u = q.removeMin();
+				stats_settled++;
+				int n = dir ? g.nIncoming(u, undirected) : g.nIncident(u, undirected);
+				for (int i = 0; i < n; i++) {
+					auto & e = dir ? g.incoming(u, i, undirected) : g.incident(u, i, undirected);
+					if (!g.edgeEnabled(e.id))
+						continue;
+					int v = e.node;
+					Weight alt = search_dist[dir][u] + g.getWeight(e.id);
+					if (search_mark[dir][v] == search_id) {
+						if (search_edge[dir][v] == -2 || !(alt < search_dist[dir][v]))
+							continue;
+						search_key[dir][v] += alt - search_dist[dir][v];
+						search_dist[dir][v] = alt;
+						search_edge[dir][v] = e.id;
+						if (q.inHeap(v))
+							q.decrease(v);
+						else
+							q.insert(v);
+					} else if (!label(dir, v, t, alt, e.id)) {
+						continue;
+					}
+					if (search_mark[1 - dir][v] == search_id && search_edge[1 - dir][v] != -2) {
+						Weight len = alt + search_dist[1 - dir][v];
+						if (len < best) {
+							best = len;
+							meet = v;
+						}
+					}
+				}
+			}
+		}
+		if (meet < 0) {
+			dist[t] = inf();
+			prev[t] = -1;
+			resolved[t] = epoch;
+			return;
+		}
+		//read back the path through the meeting node, and resolve every node on it
+		path.clear();
+		for (int u = meet; u != source;) {
+			int edgeID = search_edge[0][u];
+			path.push_back(edgeID);
+			u = otherEnd(edgeID, u);
+		}
+		std::reverse(path.begin(), path.end());
+		for (int u = meet; u != t;) {
+			int edgeID = search_edge[1][u];
+			path.push_back(edgeID);
+			u = otherEnd(edgeID, u);
+		}
+		Weight d = 0;
+		int u = source;
+		dist[u] = 0;
+		prev[u] = -1;
+		resolved[u] = epoch;
+		for (int edgeID : path) {
+			d += g.getWeight(edgeID);
+			u = otherEnd(edgeID, u);
+			dist[u] = d;
+			prev[u] = edgeID;
+			resolved[u] = epoch;
+		}
+		assert(u == t);
+		assert(dist[t] == best);
+	}
+
+	void fullSearch() {
+		stats_full_searches++;
+		searchAll(source, false, true, dist, &prev);
+		for (int u = 0; u < g.nodes(); u++)
+			resolved[u] = epoch;
+	}
+};
+}
+;
+#endif /* ASTAR_H_ */
@@ -138,7 +138,7 @@ public:
         edge_in_path.clear();//clear and rebuild the path tree
         int source = getSource();
         assert(previous_edge[source] == -1);
-        static int iter = 0;
+        static thread_local int iter = 0;
         if (++iter == 25) {
             int a = 1;
         };
@@ -207,7 +207,7 @@ public:
         last_history_clear = g.nHistoryClears();
     }
     void update() override{
-        static int iteration = 0;
+        static thread_local int iteration = 0;
         int local_it = ++iteration;
 
         if (!needs_recompute && last_modification > 0 && g.getCurrentHistory() == last_modification){
@@ -114,7 +114,7 @@ public:
 		return num_updates;
 	}
 	void update() override{
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.getCurrentHistory() == last_modification)
@@ -465,7 +465,7 @@ public:
 		return num_updates;
 	}
 	void update() override {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.getCurrentHistory() == last_modification)
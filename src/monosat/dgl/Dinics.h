@@ -114,7 +114,7 @@ public:
 	void dbg_print_graph(int from, int to) {
 #ifdef DEBUG_DGL
 		return;
-		static int it = 0;
+		static thread_local int it = 0;
 		if (++it == 6) {
 			int a = 1;
 		}
@@ -362,7 +362,7 @@ public:
 					}
 					assert(forest.findRoot(src) == forest.findRoot(v));
 				}
-				static int iter = 0;
+				static thread_local int iter = 0;
 				++iter;
 				toLink.clear();
 				dbg_print_graph(src, dst);
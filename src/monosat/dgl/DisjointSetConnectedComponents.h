@@ -97,7 +97,7 @@ public:
 	}
 	
 	void update() {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		
 		if (last_modification > 0 && g.getCurrentHistory() == last_modification) {
@@ -404,7 +404,7 @@ public:
 		 prev.resize(g.nodes(),-1);
 		 //ok, traverse the nodes connected to this component
 		 component.clear();
-		 static int iter=0;
+		 static thread_local int iter=0;
 		 //this is NOT the right way to do this.
 		 //need to only see check from t!
 		 t.getConnectedComponent(default_source,component);
@@ -45,6 +45,11 @@ namespace dgl {
  * recomputed from scratch.
  *
  * Most algorithms in the library are optimized for moderate sized, sparsely connected graphs (<10,000 edges/nodes).
+ *
+ * Once all edges have been declared, calling compact() moves the adjacency lists into a compressed sparse row (CSR)
+ * layout, with each node's edges stored contiguously in a single array. This makes traversals over large graphs much
+ * more cache friendly. Enabling, disabling or re-weighting edges leaves the graph compact; adding a new node or edge
+ * moves the adjacency lists back into the (slower, but extensible) per-node layout until compact() is called again.
  */
 template<typename Weight>
 class DynamicGraph final:public Graph<Weight> {
@@ -84,9 +89,54 @@ public:
 	int64_t historyclears=0;
 	int64_t skipped_historyclears=0;
 
+	//Note: these are empty while the graph is compact
 	std::vector<std::vector<Edge> > adjacency_list;
 	std::vector<std::vector<Edge> > inverted_adjacency_list;
 	std::vector<std::vector<Edge> > adjacency_undirected_list;
+private:
+	//Compressed sparse row adjacency, in use only while is_compact is true.
+	//The edges of node n are edges[offsets[n]] to edges[offsets[n+1]-1], in the same order as in the adjacency lists.
+	bool is_compact=false;
+	std::vector<int> out_offsets;
+	std::vector<Edge> out_edges;
+	std::vector<int> in_offsets;
+	std::vector<Edge> in_edges;
+	std::vector<int> undirected_offsets;
+	std::vector<Edge> undirected_edges;
+
+	static void toCSR(std::vector<std::vector<Edge> > & lists, std::vector<int> & offsets, std::vector<Edge> & edges){
+		size_t n_edges=0;
+		for(auto & list:lists)
+			n_edges+=list.size();
+		offsets.resize(lists.size()+1);
+		edges.clear();
+		edges.reserve(n_edges);
+		for(int n = 0;n<lists.size();n++){
+			offsets[n]=edges.size();
+			edges.insert(edges.end(),lists[n].begin(),lists[n].end());
+		}
+		offsets[lists.size()]=edges.size();
+		//release the memory of the per-node lists
+		std::vector<std::vector<Edge> >().swap(lists);
+	}
+	static void fromCSR(std::vector<int> & offsets, std::vector<Edge> & edges, std::vector<std::vector<Edge> > & lists){
+		int n_nodes = offsets.size()-1;
+		lists.resize(n_nodes);
+		for(int n = 0;n<n_nodes;n++){
+			lists[n].assign(edges.begin()+offsets[n],edges.begin()+offsets[n+1]);
+		}
+		std::vector<int>().swap(offsets);
+		std::vector<Edge>().swap(edges);
+	}
+	//Move the adjacency lists back out of the CSR layout, so that new nodes or edges can be added.
+	void expand(){
+		if(!is_compact)
+			return;
+		fromCSR(out_offsets,out_edges,adjacency_list);
+		fromCSR(in_offsets,in_edges,inverted_adjacency_list);
+		fromCSR(undirected_offsets,undirected_edges,adjacency_undirected_list);
+		is_compact=false;
+	}
 public:
 
 
@@ -122,32 +172,46 @@ public:
 	}
 	//SLOW!
 	bool hasEdge(int from, int to) const override{
-		for (int i = 0; i < adjacency_list[from].size(); i++) {
-			if (adjacency_list[from][i].node == to && edgeEnabled(adjacency_list[from][i].id)) {
-				return true;
-			}
-		}
-		return false;
+		return getEdge(from,to)>=0;
 	}
 	//SLOW! Returns -1 if there is no edge
 	int getEdge(int from, int to) const override{
-		for (int i = 0; i < adjacency_list[from].size(); i++) {
-			if (adjacency_list[from][i].node == to && edgeEnabled(adjacency_list[from][i].id)) {
-				return adjacency_list[from][i].id;
+		for (int i = 0; i < nIncidentEdges(from,false); i++) {
+			const Edge & e = incidentEdge(from,i,false);
+			if (e.node == to && edgeEnabled(e.id)) {
+				return e.id;
 			}
 		}
 		return -1;
 	}
 	bool hasEdgeUndirected(int from, int to) const override{
-		for (int i = 0; i < adjacency_undirected_list[from].size(); i++) {
-			if (adjacency_undirected_list[from][i].node == to && edgeEnabled(adjacency_undirected_list[from][i].id)) {
+		for (int i = 0; i < nIncidentEdges(from,true); i++) {
+			const Edge & e = incidentEdge(from,i,true);
+			if (e.node == to && edgeEnabled(e.id)) {
 				return true;
 			}
 		}
 		return false;
 	}
 
+	/**
+	 * Move the adjacency lists into a compressed sparse row layout (see the class comment).
+	 * Does nothing if the graph is already compact.
+	 */
+	void compact(){
+		if(is_compact)
+			return;
+		toCSR(adjacency_list,out_offsets,out_edges);
+		toCSR(inverted_adjacency_list,in_offsets,in_edges);
+		toCSR(adjacency_undirected_list,undirected_offsets,undirected_edges);
+		is_compact=true;
+	}
+	bool isCompact() const{
+		return is_compact;
+	}
+
 	int addNode() override{
+		expand();
 
 		adjacency_list.push_back( { }); //adj list
 		adjacency_undirected_list.push_back( { });
@@ -162,7 +226,6 @@ public:
 
 		if (_outfile) {
 			fprintf(_outfile, "node %d\n", num_nodes);
-			fflush(_outfile);
 		}
 
 		return num_nodes++;
@@ -188,6 +251,7 @@ public:
 	}
 	//Instead of actually adding and removing edges, tag each edge with an 'enabled/disabled' label, and just expect reading algorithms to check and respect that label.
 	int addEdge(int from, int to, int id = -1, Weight weight=1)override{
+		expand();
 		assert(from < num_nodes);
 		assert(to < num_nodes);
 		assert(from >= 0);
@@ -230,7 +294,6 @@ public:
 			std::stringstream ss;
 			ss<<weight;
 			fprintf(_outfile, "edge_weight %d %s\n", id + 1, ss.str().c_str());
-			fflush(_outfile);
 		}
 
 //		history.push_back({true,id,modifications});
@@ -249,15 +312,41 @@ public:
 		return num_edges;
 	}
 
-	inline int nIncident(int node, bool undirected = false) override{
-		assert(node >= 0);
-		assert(node < nodes());
+private:
+	inline int nIncidentEdges(int node, bool undirected) const{
+		if (is_compact) {
+			if (undirected) {
+				return undirected_offsets[node+1]-undirected_offsets[node];
+			} else {
+				return out_offsets[node+1]-out_offsets[node];
+			}
+		}
 		if (undirected) {
 			return adjacency_undirected_list[node].size();
 		} else {
 			return adjacency_list[node].size();
 		}
 	}
+	inline const Edge & incidentEdge(int node, int i, bool undirected) const{
+		if (is_compact) {
+			if (undirected) {
+				return undirected_edges[undirected_offsets[node]+i];
+			} else {
+				return out_edges[out_offsets[node]+i];
+			}
+		}
+		if (undirected) {
+			return adjacency_undirected_list[node][i];
+		} else {
+			return adjacency_list[node][i];
+		}
+	}
+public:
+	inline int nIncident(int node, bool undirected = false) override{
+		assert(node >= 0);
+		assert(node < nodes());
+		return nIncidentEdges(node, undirected);
+	}
 
 	inline int nDirectedEdges(int node, bool incoming) override{
 		assert(node >= 0);
@@ -280,7 +369,9 @@ public:
 		assert(node >= 0);
 		assert(node < nodes());
 		if (undirected) {
-			return adjacency_undirected_list[node].size();
+			return nIncidentEdges(node, true);
+		} else if (is_compact) {
+			return in_offsets[node+1]-in_offsets[node];
 		} else {
 			return inverted_adjacency_list[node].size();
 		}
@@ -290,18 +381,16 @@ public:
 		assert(node >= 0);
 		assert(node < nodes());
 		assert(i < nIncident(node, undirected));
-		if (undirected) {
-			return adjacency_undirected_list[node][i];
-		} else {
-			return adjacency_list[node][i];
-		}
+		return const_cast<Edge&>(incidentEdge(node, i, undirected));
 	}
 	inline Edge & incoming(int node, int i, bool undirected = false) override {
 		assert(node >= 0);
 		assert(node < nodes());
 		assert(i < nIncoming(node, undirected));
 		if (undirected) {
-			return adjacency_undirected_list[node][i];
+			return const_cast<Edge&>(incidentEdge(node, i, true));
+		} else if (is_compact) {
+			return in_edges[in_offsets[node]+i];
 		} else {
 			return inverted_adjacency_list[node][i];
 		}
@@ -353,7 +442,6 @@ public:
 			if (_outfile) {
 
 				fprintf(_outfile, "%d\n", id + 1);
-				fflush(_outfile);
 			}
 
 		}
@@ -375,7 +463,6 @@ public:
 					int a = 1;
 				}
 				fprintf(_outfile, "-%d\n", id + 1);
-				fflush(_outfile);
 			}
 
 			modifications--;
@@ -396,7 +483,6 @@ public:
 
 			if (_outfile) {
 				fprintf(_outfile, "-%d\n", id + 1);
-				fflush(_outfile);
 			}
 
 			modifications++;
@@ -420,7 +506,6 @@ public:
 			if (_outfile) {
 
 				fprintf(_outfile, "%d\n", id + 1);
-				fflush(_outfile);
 			}
 
 			modifications--;
@@ -456,7 +541,6 @@ public:
 			std::stringstream ss;
 			ss<<w;
 			fprintf(_outfile, "edge_weight %d %s\n", id + 1, ss.str().c_str());
-			fflush(_outfile);
 		}
 
 
@@ -474,10 +558,10 @@ public:
 			printf("n%d\n", i);
 		}
 
-		for (int i = 0; i < adjacency_list.size(); i++) {
-			for (int j = 0; j < adjacency_list[i].size(); j++) {
-				int id = adjacency_list[i][j].id;
-				int u = adjacency_list[i][j].node;
+		for (int i = 0; i < num_nodes; i++) {
+			for (int j = 0; j < nIncident(i); j++) {
+				int id = incident(i,j).id;
+				int u = incident(i,j).node;
 				const char * s = "black";
 				if (edgeEnabled(id))
 					s = "red";
@@ -607,7 +691,6 @@ public:
 
 			if (_outfile) {
 				fprintf(_outfile, "clearHistory\n");
-				fflush(_outfile);
 			}
 
 		}
@@ -622,7 +705,6 @@ public:
 
 		if (_outfile) {
 			fprintf(_outfile, "invalidate\n");
-			fflush(_outfile);
 		}
 
 	}
@@ -650,7 +732,6 @@ public:
 
 		if (_outfile) {
 			fprintf(_outfile, "markChanged\n");
-			fflush(_outfile);
 		}
 
 	}
@@ -663,7 +744,6 @@ public:
 
 		if (_outfile) {
 			fprintf(_outfile, "clearChanged\n");
-			fflush(_outfile);
 		}
 
 	}
@@ -675,6 +755,7 @@ public:
 		next_id=0;
 
 
+		expand();
 		adjacency_list.clear();
 		inverted_adjacency_list.clear();
 		adjacency_undirected_list.clear();
@@ -695,6 +776,13 @@ public:
 		to.adjacency_undirected_list=adjacency_undirected_list;
 		to.all_edges =all_edges;
 		to.inverted_adjacency_list=inverted_adjacency_list;
+		to.is_compact = is_compact;
+		to.out_offsets = out_offsets;
+		to.out_edges = out_edges;
+		to.in_offsets = in_offsets;
+		to.in_edges = in_edges;
+		to.undirected_offsets = undirected_offsets;
+		to.undirected_edges = undirected_edges;
 
 
 	}
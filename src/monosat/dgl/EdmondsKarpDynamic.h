@@ -196,7 +196,7 @@ public:
 		int s = source;
 		int t = sink;
 		//see http://cstheory.stackexchange.com/a/10186
-		static int it = 0;
+		static thread_local int it = 0;
 		if (++it == 56) {
 			int a = 1;
 		}
@@ -671,7 +671,7 @@ private:
 	void dbg_print_graph(int from, int to, Weight shortCircuitFrom = -1, Weight shortCircuitTo = -1) {
 #ifdef DEBUG_DGL
 		return;
-		static int it = 0;
+		static thread_local int it = 0;
 		if (++it == 6) {
 			int a = 1;
 		}
@@ -23,14 +23,26 @@
 #define FLOYD_WARSHALL_H_
 
 #include <vector>
+#include <algorithm>
 #include "monosat/dgl/alg/Heap.h"
 #include "Graph.h"
 #include "monosat/core/Config.h"
 #include "AllPairs.h"
 #include "monosat/mtl/Sort.h"
+#include "monosat/core/WorkerPool.h"
 
 namespace dgl {
 
+/**
+ * All-pairs (unweighted) shortest paths, by Floyd-Warshall.
+ *
+ * The distance and path matrices are stored as flat, row-major arrays, with rows padded to a multiple of the block size.
+ * The recurrence is computed in blocks (the standard three phase blocked Floyd-Warshall): for each diagonal block, first
+ * the diagonal block itself is closed, then the blocks in its row and column, and then all remaining blocks; so each
+ * pass of the inner loops works on three blocks that fit in cache, rather than streaming the whole matrix once per node.
+ * The innermost loop is a branch-free min-plus update over a contiguous row, which the compiler vectorizes.
+ * Within the second and third phases, blocks are independent, and are updated in parallel if -allpairs-threads > 1.
+ */
 template<typename Weight, typename Graph = DynamicGraph<Weight>, class Status = AllPairs::NullStatus>
 class FloydWarshall: public AllPairs {
 public:
@@ -52,8 +64,12 @@ public:
 //	std::vector<int> check;
 	const int reportPolarity;
 
-	std::vector<std::vector<int> > dist;
-	std::vector<std::vector<int> > next;
+	static const int BLOCK = 64;
+	int n_nodes = 0;
+	int stride = 0; //row length of dist and next: the number of nodes, rounded up to a multiple of BLOCK
+	std::vector<int> dist; //dist[i*stride + j] is the distance from i to j
+	std::vector<int> next; //next[i*stride + j] is an intermediate node on the shortest path from i to j, or -1
+	Monosat::WorkerPool * pool = nullptr;
 
 public:
 	int stats_full_updates;
@@ -81,6 +97,10 @@ public:
 		stats_num_skipable_deletions = 0;
 		stats_fast_failed_updates = 0;
 	}
+
+	~FloydWarshall() override {
+		delete pool;
+	}
 	
 	void addSource(int s) override {
 		assert(!std::count(sources.begin(), sources.end(), s));
@@ -98,16 +118,10 @@ public:
 		for (int i = 0; i < n; i++)
 			order.push_back(i);
 		INF = g.nodes() + 1;
-		if (dist.size() < n) {
-			dist.resize(n);
-			for (int i = 0; i < dist.size(); i++)
-				dist[i].resize(n);
-		}
-		if (next.size()<n){
-			next.resize(n);
-			for (int i = 0; i < next.size(); i++)
-				next[i].resize(n);
-		}
+		n_nodes = n;
+		stride = ((n + BLOCK - 1) / BLOCK) * BLOCK;
+		dist.resize(stride * stride);
+		next.resize(stride * stride);
 	}
 	
 	struct lt_key {
@@ -141,35 +155,46 @@ public:
 		
 		setNodes(g.nodes());
 		
-		for (int i = 0; i < g.nodes(); i++) {
-			for (int j = 0; j < g.nodes(); j++) {
-				next[i][j] = -1;
-				dist[i][j] = INF;
-			}
-			dist[i][i] = 0;
-		}
+		std::fill(next.begin(), next.end(), -1);
+		std::fill(dist.begin(), dist.end(), INF);
+		for (int i = 0; i < stride; i++)
+			dist[i * stride + i] = 0;
 		
 		for (int i = 0; i < g.edges(); i++) {
 			if (g.hasEdge(i) && g.edgeEnabled(i)) {
 				int u = g.getEdge(i).from;
 				int v = g.getEdge(i).to;
 				if (u != v)
-					dist[u][v] = 1;
+					dist[u * stride + v] = 1;
 			}
 		}
 		
 		//for(int l = 0;l<sources.size();l++){
 		//	int k = sources[l];
-		for (int k = 0; k < g.nodes(); k++) {
-			for (int i = 0; i < g.nodes(); i++) {
-				for (int j = 0; j < g.nodes(); j++) {
-					int d = dist[i][k] + dist[k][j];
-					if (d < dist[i][j]) {
-						dist[i][j] = d;
-						next[i][j] = k;
-					}
+		int n_blocks = stride / BLOCK;
+		if (Monosat::opt_allpairs_threads > 1 && n_blocks > 2 && !pool)
+			pool = new Monosat::WorkerPool(Monosat::opt_allpairs_threads);
+		for (int kb = 0; kb < n_blocks; kb++) {
+			//phase 1: the diagonal block
+			relaxBlock(kb, kb, kb);
+			//phase 2: the rest of row kb and column kb, which depend only on themselves and the diagonal block
+			forEach(2 * (n_blocks - 1), [&](int t) {
+				int b = t / 2;
+				if (b >= kb)
+					b++;
+				if (t % 2)
+					relaxBlock(kb, b, kb);
+				else
+					relaxBlock(b, kb, kb);
+			});
+			//phase 3: all other blocks, which depend on row kb and column kb
+			forEach(n_blocks - 1, [&](int t) {
+				int ib = t >= kb ? t + 1 : t;
+				for (int jb = 0; jb < n_blocks; jb++) {
+					if (jb != kb)
+						relaxBlock(ib, jb, kb);
 				}
-			}
+			});
 		}
 		for (int i = 0; i < sources.size(); i++) {
 			int s = sources[i];
@@ -181,12 +206,12 @@ public:
 				 }*/
 				//Wrong. This is only required if we are returning learnt clauses that include other reachability lits.
 				//it is crucial to return the nodes in order of distance, so that they are enqueued in the correct order in the solver.
-				if (dist[s][u] >= INF && reportPolarity < 1) {
+				if (dist[s * stride + u] >= INF && reportPolarity < 1) {
 					status.setReachable(s, u, false);
 					status.setMininumDistance(s, u, false, INF);
-				} else if (dist[s][u] < INF && reportPolarity > -1) {
+				} else if (dist[s * stride + u] < INF && reportPolarity > -1) {
 					status.setReachable(s, u, true);
-					status.setMininumDistance(s, u, true, dist[s][u]);
+					status.setMininumDistance(s, u, true, dist[s * stride + u]);
 				}
 			}
 			/*	for(int u = 0;u<g.nodes();u++){
@@ -210,6 +235,42 @@ public:
 		
 	}
 	
+private:
+	//Call task(t) for each t in [0,n), in parallel if a worker pool is available.
+	template<typename Task>
+	void forEach(int n, const Task & task) {
+		if (pool && n > 1) {
+			pool->run(n, task);
+		} else {
+			for (int t = 0; t < n; t++)
+				task(t);
+		}
+	}
+
+	//Relax each path in block (ib,jb) through the intermediate nodes of block kb.
+	void relaxBlock(int ib, int jb, int kb) {
+		const int i0 = ib * BLOCK;
+		const int j0 = jb * BLOCK;
+		const int k0 = kb * BLOCK;
+		for (int k = k0; k < k0 + BLOCK; k++) {
+			const int * dk = &dist[k * stride + j0];
+			for (int i = i0; i < i0 + BLOCK; i++) {
+				const int dik = dist[i * stride + k];
+				if (dik >= INF)
+					continue;
+				int * di = &dist[i * stride + j0];
+				int * ni = &next[i * stride + j0];
+				for (int j = 0; j < BLOCK; j++) {
+					int d = dik + dk[j];
+					bool shorter = d < di[j];
+					di[j] = shorter ? d : di[j];
+					ni[j] = shorter ? k : ni[j];
+				}
+			}
+		}
+	}
+
+public:
 	void getPath(int from, int to, std::vector<int> & path) override {
 		update();
 		path.push_back(from);
@@ -218,8 +279,8 @@ public:
 		path.push_back(to);
 	}
 	void getPath_private(int from, int to, std::vector<int> & path) {
-		assert(dist[from][to] < INF);
-		int intermediate = next[from][to];
+		assert(dist[from * stride + to] < INF);
+		int intermediate = next[from * stride + to];
 		if (intermediate > -1) {
 			getPath_private(from, intermediate, path);
 			path.push_back(intermediate);
@@ -269,7 +330,7 @@ public:
 	}
 	
 	bool connected_unsafe(int from, int t) override {
-		return dist[from][t] < INF;
+		return dist[from * stride + t] < INF;
 	}
 	bool connected_unchecked(int from, int t) override {
 		assert(last_modification == g.getCurrentHistory());
@@ -281,17 +342,17 @@ public:
 		
 		assert(dbg_uptodate());
 		
-		return dist[from][t] < INF;
+		return dist[from * stride + t] < INF;
 	}
 	int distance(int from, int t) override {
 		if (connected(from, t))
-			return dist[from][t];
+			return dist[from * stride + t];
 		else
 			return INF;
 	}
 	int distance_unsafe(int from, int t) override {
 		if (connected_unsafe(from, t))
-			return dist[from][t];
+			return dist[from * stride + t];
 		else
 			return INF;
 	}
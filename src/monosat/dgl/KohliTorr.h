@@ -28,6 +28,7 @@
 #include "Graph.h"
 #include "DynamicGraph.h"
 #include "MaxFlow.h"
+#include <atomic>
 #include <vector>
 
 #include "EdmondsKarpDynamic.h"
@@ -602,7 +603,7 @@ public:
 		if (same_source_sink)
 			return INF;
 		//see http://cstheory.stackexchange.com/a/10186
-		static int it = 0;
+		static thread_local int it = 0;
 		if (++it == 54) {
 			int a = 1;
 		}
@@ -902,7 +903,7 @@ private:
 
 		if (edge_enabled.size() < g.edges())
 			return;
-		static int it = 0;
+		static thread_local int it = 0;
 		if (++it == 6) {
 			int a = 1;
 		}
@@ -1268,7 +1269,7 @@ public:
 namespace dgl {
 template<typename Weight>
 class KohliTorr : public EdmondsKarpDynamic<Weight> {
-    static bool warning_issued;
+    static std::atomic<bool> warning_issued;
 public:
     double stats_calc_time = 0;
     double stats_flow_time = 0;
@@ -1291,7 +1292,7 @@ public:
     }
 };
 template<typename Weight>
-bool KohliTorr<Weight>::warning_issued = false;
+std::atomic<bool> KohliTorr<Weight>::warning_issued(false);
 }
 #endif
 
@@ -0,0 +1,295 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MULTISOURCEBFS_H_
+#define MULTISOURCEBFS_H_
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include "Graph.h"
+#include "DynamicGraph.h"
+#include "Reach.h"
+
+namespace dgl {
+
+/**
+ * Computes the set of nodes reachable from each of many sources at once.
+ * Each source is assigned a 'lane' (one bit position); each node stores one bit per lane, packed into 64-bit words.
+ * A single worklist traversal then propagates all lanes simultaneously, word by word, so that 64 sources
+ * cost about as much as one ordinary BFS (and wider sets of lanes are processed 64 at a time, in a tight loop over
+ * contiguous words that the compiler can vectorize).
+ *
+ * Only reachability is tracked, not paths; see MultiSourceReach for the single-source Reach interface to one lane.
+ */
+template<typename Weight, typename Graph = DynamicGraph<Weight>>
+class MultiSourceBFS {
+	Graph & g;
+	std::vector<int> sources;
+	int n_words = 0;
+	//bits[u*n_words + w] holds the lanes 64*w to 64*w+63 of node u
+	std::vector<uint64_t> bits;
+	std::vector<int> q;
+	std::vector<char> in_queue;
+
+	int last_modification = -1;
+	int last_addition = -1;
+	int last_deletion = -1;
+	int history_qhead = 0;
+	int last_history_clear = 0;
+	int64_t num_updates = 0;
+	//lanes may be updated concurrently by different detectors (see opt_graph_prop_threads)
+	std::mutex update_mutex;
+
+	void enqueue(int u) {
+		if (!in_queue[u]) {
+			in_queue[u] = true;
+			q.push_back(u);
+		}
+	}
+
+	//Propagate all lanes from the nodes in the queue until nothing changes
+	void propagate() {
+		for (int i = 0; i < q.size(); i++) {
+			int u = q[i];
+			in_queue[u] = false;
+			const uint64_t * from_bits = &bits[(size_t) u * n_words];
+			for (int j = 0; j < g.nIncident(u); j++) {
+				auto & edge = g.incident(u, j);
+				if (!g.edgeEnabled(edge.id))
+					continue;
+				int v = edge.node;
+				uint64_t * to_bits = &bits[(size_t) v * n_words];
+				uint64_t changed = 0;
+				for (int w = 0; w < n_words; w++) {
+					uint64_t new_bits = from_bits[w] & ~to_bits[w];
+					to_bits[w] |= new_bits;
+					changed |= new_bits;
+				}
+				if (changed)
+					enqueue(v);
+			}
+		}
+		q.clear();
+	}
+
+	void recomputeAll() {
+		stats_full_updates++;
+		n_words = (sources.size() + 63) / 64;
+		bits.clear();
+		bits.resize((size_t) g.nodes() * n_words, 0);
+		in_queue.clear();
+		in_queue.resize(g.nodes(), false);
+		q.clear();
+		for (int lane = 0; lane < sources.size(); lane++) {
+			int s = sources[lane];
+			bits[(size_t) s * n_words + lane / 64] |= ((uint64_t) 1) << (lane % 64);
+			enqueue(s);
+		}
+		propagate();
+	}
+
+	//If edges have only been enabled since the last update, then reachability can only grow,
+	//and only from the sources of the newly enabled edges.
+	bool updateAdditions() {
+		if (g.nHistoryClears() != last_history_clear || g.nodes() != in_queue.size())
+			return false;
+		if (last_deletion != g.nDeletions())
+			return false;
+		if (g.historySize() < history_qhead || g.getCurrentHistory() < last_modification)
+			return false;//history was rewound
+		for (int i = history_qhead; i < g.historySize(); i++) {
+			auto & change = g.getChange(i);
+			if (change.addition && g.edgeEnabled(change.id))
+				enqueue(g.getEdge(change.id).from);
+		}
+		stats_fast_updates++;
+		propagate();
+		return true;
+	}
+
+public:
+	int64_t stats_full_updates = 0;
+	int64_t stats_fast_updates = 0;
+	int64_t stats_skipped_updates = 0;
+
+	MultiSourceBFS(Graph & graph) :
+			g(graph) {
+	}
+
+	/**
+	 * Add a source, returning its lane. Adding a source forces the next update to recompute all lanes.
+	 */
+	int addSource(int s) {
+		sources.push_back(s);
+		last_modification = -1;
+		return sources.size() - 1;
+	}
+
+	int nSources() const {
+		return sources.size();
+	}
+
+	int getSource(int lane) const {
+		return sources[lane];
+	}
+
+	int64_t numUpdates() const {
+		return num_updates;
+	}
+
+	void update() {
+		std::lock_guard<std::mutex> lock(update_mutex);
+		if (last_modification > 0 && g.getCurrentHistory() == last_modification) {
+			stats_skipped_updates++;
+			return;
+		}
+		if (last_modification <= 0 || !updateAdditions()) {
+			recomputeAll();
+		}
+		num_updates++;
+		last_modification = g.getCurrentHistory();
+		last_deletion = g.nDeletions();
+		last_addition = g.nAdditions();
+		history_qhead = g.historySize();
+		last_history_clear = g.nHistoryClears();
+	}
+
+	//True if t is reachable from the source of the given lane (as of the last update)
+	bool connected_unsafe(int lane, int t) const {
+		if (t < 0 || (size_t) t * n_words >= bits.size())
+			return false;
+		return (bits[(size_t) t * n_words + lane / 64] >> (lane % 64)) & 1;
+	}
+
+	bool upToDate() const {
+		return last_modification > 0 && g.getCurrentHistory() == last_modification;
+	}
+};
+
+/**
+ * Single-source Reach interface to one lane of a shared MultiSourceBFS.
+ * Updating any lane brings all lanes up to date; each lane then reports the status changes of its own source,
+ * the same way as BFSReachability does.
+ * Paths are not tracked, so previous() and incomingEdge() are not supported; pair this with a separate
+ * path-finding algorithm (which only needs to be updated when a path is actually required).
+ */
+template<typename Weight, typename Graph = DynamicGraph<Weight>, class Status = Reach::NullStatus>
+class MultiSourceReach: public Reach {
+	MultiSourceBFS<Weight, Graph> & shared;
+	Graph & g;
+	Status & status;
+	const int reportPolarity;
+	int source;
+	int lane;
+	int64_t last_reported = -1;
+	//if any destinations are set, only the status of those nodes is reported
+	std::vector<int> destinations;
+	std::vector<bool> is_destination;
+	void report(int u) {
+		bool reached = shared.connected_unsafe(lane, u);
+		if (reached && reportPolarity >= 0) {
+			status.setReachable(u, true);
+		} else if (!reached && reportPolarity <= 0) {
+			status.setReachable(u, false);
+		}
+	}
+public:
+	MultiSourceReach(MultiSourceBFS<Weight, Graph> & shared, int s, Graph & graph, Status & status,
+					 int reportPolarity = 0) :
+			shared(shared), g(graph), status(status), reportPolarity(reportPolarity), source(s) {
+		lane = shared.addSource(s);
+	}
+
+	int numUpdates() const override {
+		return shared.numUpdates();
+	}
+	void setSource(int s) override {
+		if (s != source) {
+			source = s;
+			lane = shared.addSource(s);
+			last_reported = -1;
+		}
+	}
+	int getSource() override {
+		return source;
+	}
+
+	void addDestination(int node) override {
+		if (node >= is_destination.size())
+			is_destination.resize(node + 1, false);
+		if (!is_destination[node]) {
+			is_destination[node] = true;
+			destinations.push_back(node);
+			last_reported = -1;
+		}
+	}
+	void removeDestination(int node) override {
+		if (node < is_destination.size() && is_destination[node]) {
+			is_destination[node] = false;
+			destinations.erase(std::find(destinations.begin(), destinations.end(), node));
+		}
+	}
+
+	void update() override {
+		shared.update();
+		if (last_reported == shared.numUpdates())
+			return;
+		last_reported = shared.numUpdates();
+		if (destinations.size()) {
+			for (int u : destinations)
+				report(u);
+		} else {
+			for (int u = 0; u < g.nodes(); u++)
+				report(u);
+		}
+	}
+
+	bool connected_unsafe(int t) override {
+		return shared.connected_unsafe(lane, t);
+	}
+	bool connected_unchecked(int t) override {
+		assert(shared.upToDate());
+		return connected_unsafe(t);
+	}
+	bool connected(int t) override {
+		update();
+		return connected_unsafe(t);
+	}
+	int previous(int node) override {
+		throw std::logic_error("Multi-source reachability does not track paths");
+	}
+	int incomingEdge(int node) override {
+		throw std::logic_error("Multi-source reachability does not track paths");
+	}
+	void printStats() override {
+		printf("Multi-source BFS (%d sources): %" PRId64 " full updates, %" PRId64 " fast updates, %" PRId64 " skipped\n",
+			   shared.nSources(), shared.stats_full_updates, shared.stats_fast_updates, shared.stats_skipped_updates);
+	}
+};
+}
+;
+#endif /* MULTISOURCEBFS_H_ */
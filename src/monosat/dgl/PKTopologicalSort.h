@@ -479,7 +479,7 @@ private:
 			return;
 		}
 		//assert ords are unique
-		static std::vector<bool> seen;
+		static thread_local std::vector<bool> seen;
 		seen.clear();
 		seen.resize(g.nodes());
 		for(int i = 0;i<ord.size();i++){
@@ -505,7 +505,7 @@ private:
 
 public:
 	void update()override {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 
 
 		if (last_modification > 0 && g.getCurrentHistory() == last_modification) {
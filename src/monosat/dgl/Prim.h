@@ -126,7 +126,7 @@ public:
 		return num_updates;
 	}
 	void update() {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 
 		if (g.outfile()) {
@@ -35,6 +35,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <atomic>
 #include <vector>
 #ifndef NDEBUG
 //#define DEBUG_RAMAL
@@ -44,7 +45,7 @@ namespace dgl {
 template<typename Weight = int, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus>
 class RamalReps: public Distance<Weight>, public DynamicGraphAlgorithm {
 public:
-	static bool ever_warned_about_zero_weights;
+	static std::atomic<bool> ever_warned_about_zero_weights;
 	Graph & g;
 	std::vector<Weight> & weights;
 	std::vector<Weight> local_weights;
@@ -289,7 +290,7 @@ public:
 	}
 
 	void AddEdge(int edgeID) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 		dbg_delta_lite();
 		assert(g.edgeEnabled(edgeID));
@@ -399,7 +400,7 @@ public:
 
 	//Called if an edge weight is decreased
 	void DecreaseWeight(int edgeID) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 		dbg_delta_lite();
 		assert(g.edgeEnabled(edgeID));
@@ -835,7 +836,7 @@ public:
 			//fprintf(g.outfile(), "r %d\n", getSource());
 		}
 
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		if (local_it == 7668) {
 			int a = 1;
@@ -1438,7 +1439,7 @@ public:
 		return true;
 	}
 	void AddEdge(int edgeID) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 		dbg_delta_lite();
 		assert(g.edgeEnabled(edgeID));
@@ -2127,7 +2128,7 @@ public:
 	}
 };
 template<typename Weight, typename Graph, class Status>
-bool RamalReps<Weight,Graph,Status>::ever_warned_about_zero_weights = false;
+std::atomic<bool> RamalReps<Weight,Graph,Status>::ever_warned_about_zero_weights(false);
 }
 ;
 #endif
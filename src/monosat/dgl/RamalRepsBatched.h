@@ -37,6 +37,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <atomic>
 #include <vector>
 /*#ifndef NDEBUG
 #define DEBUG_RAMAL
@@ -46,7 +47,7 @@ namespace dgl {
 template<typename Weight = int, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus>
 class RamalRepsBatched: public Distance<Weight>, public DynamicGraphAlgorithm {
 public:
-    static bool ever_warned_about_zero_weights;
+    static std::atomic<bool> ever_warned_about_zero_weights;
     Graph & g;
     std::vector<Weight> & weights;
     std::vector<Weight> local_weights;
@@ -294,7 +295,7 @@ public:
 
     //Called when an edge is enabled
     void AddEdge(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
 
         assert(g.edgeEnabled(edgeID));
@@ -367,7 +368,7 @@ public:
 
     //Called if an edge weight is decreased
     void DecreaseWeight(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
 
         assert(g.edgeEnabled(edgeID));
@@ -506,7 +507,7 @@ public:
             //fprintf(g.outfile(), "r %d\n", getSource());
         }
 
-        static int iteration = 0;
+        static thread_local int iteration = 0;
         int local_it = ++iteration;
         if (local_it == 5) {
             int a = 1;
@@ -1452,7 +1453,7 @@ public:
     }
 
     void AddEdge(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
         dbg_delta_lite();
         assert(g.edgeEnabled(edgeID));
@@ -2390,7 +2391,7 @@ public:
     }
 };
 template<typename Weight,typename Graph, class Status>
-bool RamalRepsBatched<Weight,Graph,Status>::ever_warned_about_zero_weights = false;
+std::atomic<bool> RamalRepsBatched<Weight,Graph,Status>::ever_warned_about_zero_weights(false);
 }
 ;
 #endif
@@ -36,6 +36,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <atomic>
 #include <vector>
 /*#ifndef NDEBUG
 #define DEBUG_RAMAL
@@ -45,7 +46,7 @@ namespace dgl {
 template<typename Weight = int, typename Graph = DynamicGraph<Weight>, class Status = typename Distance<Weight>::NullStatus>
 class RamalRepsBatchedUnified: public Distance<Weight>, public DynamicGraphAlgorithm {
 public:
-    static bool ever_warned_about_zero_weights;
+    static std::atomic<bool> ever_warned_about_zero_weights;
     Graph & g;
     std::vector<Weight> & weights;
     std::vector<Weight> local_weights;
@@ -293,7 +294,7 @@ public:
 
     //Called when an edge is enabled
     void AddEdge(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
 
         assert(g.edgeEnabled(edgeID));
@@ -367,7 +368,7 @@ public:
 
     //Called if an edge weight is decreased
     void DecreaseWeight(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
 
         assert(g.edgeEnabled(edgeID));
@@ -508,7 +509,7 @@ public:
             //fprintf(g.outfile(), "r %d\n", getSource());
         }
 
-        static int iteration = 0;
+        static thread_local int iteration = 0;
         int local_it = ++iteration;
         if (local_it == 5) {
             int a = 1;
@@ -1371,7 +1372,7 @@ public:
     }
 
     void AddEdge(int edgeID) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
         dbg_delta_lite();
         assert(g.edgeEnabled(edgeID));
@@ -2156,7 +2157,7 @@ public:
     }
 };
 template<typename Weight,typename Graph, class Status>
-bool RamalRepsBatchedUnified<Weight,Graph,Status>::ever_warned_about_zero_weights = false;
+std::atomic<bool> RamalRepsBatchedUnified<Weight,Graph,Status>::ever_warned_about_zero_weights(false);
 }
 ;
 #endif
@@ -150,11 +150,11 @@ public:
 			printf("n%d\n", i);
 		}*/
 
-		for (int i = 0; i < g.adjacency_list.size(); i++) {
-			for (int j = 0; j < g.adjacency_list[i].size(); j++) {
-				int id = g.adjacency_list[i][j].id;
+		for (int i = 0; i < g.nodes(); i++) {
+			for (int j = 0; j < g.nIncident(i); j++) {
+				int id = g.incident(i, j).id;
 
-				int u = g.adjacency_list[i][j].node;
+				int u = g.incident(i, j).node;
 				const char * s = "black";
 				if(in_tree[id]){
 					s="green";
@@ -654,7 +654,7 @@ public:
 		return num_updates;
 	}
 	void update() override{
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 
 		if (g.outfile()) {
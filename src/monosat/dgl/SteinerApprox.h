@@ -98,7 +98,7 @@ public:
 	}
 
 	void update() {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 
 		if (g.outfile()) {
@@ -420,7 +420,7 @@ private:
 					//note: we only visit this search loop if we have not already found a replacement edge.
 					int w = n ? treeEdge.to : treeEdge.from;
 					dbg_incident();
-					static int iter = 0;
+					static thread_local int iter = 0;
 					if (++iter == 93) {
 						int a = 1;
 						int b = 2;
@@ -731,7 +731,7 @@ public:
 	 * Returns true if the set of connected components have changed
 	 */
 	bool setEdgeEnabled(int from, int to, int edgeID, bool enabled) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 531) {
 			int a = 1;
 		}
@@ -761,7 +761,7 @@ public:
 		return changed;
 	}
 	bool setEdgeEnabledUnchecked(int from, int to, int edgeID, bool connected) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 531) {
 			int a = 1;
 		}
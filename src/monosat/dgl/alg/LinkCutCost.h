@@ -350,7 +350,7 @@ public:
 
 	void dbg_isGrossMin(int min, int v) {
 #ifdef DEBUG_DGL_LINKCUT
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 22349) {
 			int a = 1;
 		}
@@ -589,7 +589,7 @@ public:
 
 	//Run edmonds-karp to remove any excess flow on t-edges
 	void clear_t_edges(int source_node, int sink_node) {
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 96) {
 			int a = 1;
 		}
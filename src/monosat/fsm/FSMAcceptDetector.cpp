@@ -20,6 +20,8 @@
  **************************************************************************************************/
 #include "monosat/fsm/alg/NFAGraphAccept.h"
 #include "monosat/fsm/alg/NFAAccept.h"
+#include "monosat/fsm/alg/NFABitAccept.h"
+#include "monosat/fsm/alg/NFATrieAccept.h"
 #include "monosat/fsm/FSMAcceptDetector.h"
 #include "monosat/fsm/FSMTheory.h"
 
@@ -32,7 +34,13 @@ FSMAcceptDetector::FSMAcceptDetector(int detectorID, FSMTheorySolver * outer, Dy
 
 	underReachStatus = new FSMAcceptDetector::AcceptStatus(*this, true);
 	overReachStatus = new FSMAcceptDetector::AcceptStatus(*this, false);
-	if(!opt_fsm_as_graph) {
+	if(opt_fsm_trie){
+		underapprox_detector = new NFATrieAccept<FSMAcceptDetector::AcceptStatus>(g_under, source, str, *underReachStatus);
+		overapprox_detector = new NFATrieAccept<FSMAcceptDetector::AcceptStatus>(g_over, source, str, *overReachStatus);
+	}else if(opt_fsm_bit_parallel){
+		underapprox_detector = new NFABitAccept<FSMAcceptDetector::AcceptStatus>(g_under, source, str, *underReachStatus);
+		overapprox_detector = new NFABitAccept<FSMAcceptDetector::AcceptStatus>(g_over, source, str, *overReachStatus);
+	}else if(!opt_fsm_as_graph) {
 		underapprox_detector = new NFAAccept<FSMAcceptDetector::AcceptStatus>(g_under, source, str, *underReachStatus,
 																			  opt_fsm_track_used_transitions);
 		overapprox_detector = new NFAAccept<FSMAcceptDetector::AcceptStatus>(g_over, source, str, *overReachStatus,
@@ -222,7 +230,7 @@ Lit FSMAcceptDetector::decide(int level){
 }
 
 bool FSMAcceptDetector::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 17) {
 		int a = 1;
 	}
@@ -576,7 +584,7 @@ bool FSMAcceptDetector::checkSymmetryConstraintsPopCount(vec<Lit> & conflict) {
 
 
 void FSMAcceptDetector::buildAcceptReason(int node,int str, vec<Lit> & conflict){
-	static int iter = 0;
+	static thread_local int iter = 0;
 	++iter;
 //find a path - ideally, the one that traverses the fewest unique transitions - from source to node, learn that one of the transitions on that path must be disabled.
 /*	g_under.draw(source);
@@ -586,7 +594,7 @@ void FSMAcceptDetector::buildAcceptReason(int node,int str, vec<Lit> & conflict)
 		printf("%d ",s);
 	}
 	printf("\"\n");*/
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	bool hasPath =underapprox_detector->getPath(str,node,path);
 	assert(hasPath);
@@ -603,7 +611,7 @@ void FSMAcceptDetector::buildAcceptReason(int node,int str, vec<Lit> & conflict)
 }
 void FSMAcceptDetector::buildNonAcceptReason(int node,int str, vec<Lit> & conflict){
 
-	static int iter = 0;
+	static thread_local int iter = 0;
 //optionally, remove all transitions from the graph that would not be traversed by this string operating on the level 0 overapprox graph.
 
 	//This doesn't work:
@@ -614,8 +622,8 @@ void FSMAcceptDetector::buildNonAcceptReason(int node,int str, vec<Lit> & confli
 	//graph must be unrolled to length of string.
 
 	//instead of actually unrolling the graph, I am going to traverse it backwards, 'unrolling it' implicitly.
-	static vec<int> to_visit;
-	static vec<int> next_visit;
+	static thread_local vec<int> to_visit;
+	static thread_local vec<int> next_visit;
 	vec<int> & string = strings[str];
 	/*
 	g_over.draw(source);
@@ -638,8 +646,8 @@ void FSMAcceptDetector::buildNonAcceptReason(int node,int str, vec<Lit> & confli
 	to_visit.clear();
 	next_visit.clear();
 
-	static vec<bool> cur_seen;
-	static vec<bool> next_seen;
+	static thread_local vec<bool> cur_seen;
+	static thread_local vec<bool> next_seen;
 	cur_seen.clear();
 	cur_seen.growTo(g_under.states());
 
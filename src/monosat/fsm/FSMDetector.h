@@ -25,6 +25,7 @@
 
 #include "monosat/mtl/Vec.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/Profile.h"
 #include <cstdio>
 #include <iostream>
 namespace Monosat {
@@ -55,6 +56,9 @@ public:
 	double stats_decide_time = 0;
 	int64_t stats_under_clause_length = 0;
 	int64_t stats_over_clause_length = 0;
+	//Call counts and timings of propagate() and buildReason(), maintained by the theory (see -profile)
+	ProfileCounter stats_propagate_profile;
+	ProfileCounter stats_reason_profile;
 
 	int getID() {
 		return detectorID;
@@ -31,8 +31,8 @@ FSMGeneratesDetector::FSMGeneratesDetector(int detectorID, FSMTheorySolver * out
 	underReachStatus = new FSMGeneratesDetector::GenerateStatus(*this, true);
 	overReachStatus = new FSMGeneratesDetector::GenerateStatus(*this, false);
 
-	underapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_under,source,str,*underReachStatus);
-	overapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_over,source,str,*overReachStatus);
+	underapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_under,source,str,*underReachStatus,opt_fsm_bit_parallel);
+	overapprox_detector = new NFAGenerate<FSMGeneratesDetector::GenerateStatus>(g_over,source,str,*overReachStatus,opt_fsm_bit_parallel);
 
 	underprop_marker = outer->newReasonMarker(getID());
 	overprop_marker = outer->newReasonMarker(getID());
@@ -93,7 +93,7 @@ void FSMGeneratesDetector::GenerateStatus::generates(int string,bool generates){
 
 
 bool FSMGeneratesDetector::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 87) {
 		int a = 1;
 	}
@@ -203,7 +203,7 @@ void FSMGeneratesDetector::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 }
 
 void FSMGeneratesDetector::buildGeneratesReason(int str, vec<Lit> & conflict){
-	static int iter = 0;
+	static thread_local int iter = 0;
 	++iter;
 //find a path - ideally, the one that traverses the fewest unique transitions - from source to node, learn that one of the transitions on that path must be disabled.
 /*	g_under.draw(source);
@@ -213,7 +213,7 @@ void FSMGeneratesDetector::buildGeneratesReason(int str, vec<Lit> & conflict){
 		printf("%d ",s);
 	}
 	printf("\"\n");*/
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	bool hasPath =underapprox_detector->getPath(str,path);
 	assert(hasPath);
@@ -311,7 +311,7 @@ bool FSMGeneratesDetector::unique_path_conflict(int s,int string,int str_pos,int
 
 void FSMGeneratesDetector::buildNonGeneratesReason(int str, vec<Lit> & conflict){
 
-	static int iter = 0;
+	static thread_local int iter = 0;
 
 
 	vec<int> & string = strings[str];
@@ -321,7 +321,7 @@ void FSMGeneratesDetector::buildNonGeneratesReason(int str, vec<Lit> & conflict)
 	if(++iter==10189){
 		int a=1;
 	}
-	static vec<NFATransition> ignore;
+	static thread_local vec<NFATransition> ignore;
 	ignore.clear();
 	unique_path_conflict(source, str, 0,0,ignore,conflict);
 
@@ -331,8 +331,8 @@ void FSMGeneratesDetector::printSolution(std::ostream& out){
 
 
 
-	static vec<NFATransition> ignore;
-	static vec<Lit> ignore_conf;
+	static thread_local vec<NFATransition> ignore;
+	static thread_local vec<Lit> ignore_conf;
 	for(int str = 0;str<strings.size();str++){
 		ignore.clear();
 		ignore_conf.clear();
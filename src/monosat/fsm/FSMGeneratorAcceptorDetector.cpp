@@ -458,7 +458,7 @@ bool FSMGeneratorAcceptorDetector::checkNegatedPolarity(){
 };
 
 bool FSMGeneratorAcceptorDetector::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 154696) {
 		int a = 1;
 	}
@@ -829,14 +829,14 @@ void FSMGeneratorAcceptorDetector::buildReason(Lit p, vec<Lit> & reason, CRef ma
 }
 
 void FSMGeneratorAcceptorDetector::buildAcceptReason(int genFinal, int acceptFinal, vec<Lit> & conflict){
-	static int iter = 0;
+	static thread_local int iter = 0;
 	++iter;
 	if(this->gen_source>1){
 		int a=1;
 	}
 //find a path - ideally, the one that traverses the fewest unique transitions - from source to node, learn that one of the transitions on that path must be disabled.
 	if(!opt_fsm_negate_underapprox){
-		static vec<NFATransition> path;
+		static thread_local vec<NFATransition> path;
 		path.clear();
 		underapprox_detector->getGeneratorPath(genFinal,acceptFinal,path);
 
@@ -859,7 +859,7 @@ void FSMGeneratorAcceptorDetector::buildAcceptReason(int genFinal, int acceptFin
 		//run an NFA to find all transitions that accepting prefixes use.
 		//printf("conflict %d\n",iter);
 		//g_over.draw(gen_source,genFinal);
-		static vec<NFATransition> path;
+		static thread_local vec<NFATransition> path;
 		path.clear();
 		inverted_overapprox_detector->getGeneratorPath(genFinal,acceptFinal,path,false,true);
 
@@ -1469,7 +1469,7 @@ void  FSMGeneratorAcceptorDetector::buildNonSuffixAcceptReason(int genFinal, int
 
 void FSMGeneratorAcceptorDetector::buildNonAcceptReason(int genFinal, int acceptFinal, vec<Lit> & conflict){
 
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	if(this->gen_source>1){
 		int a=1;
@@ -1480,7 +1480,7 @@ void FSMGeneratorAcceptorDetector::buildNonAcceptReason(int genFinal, int accept
 	//g_over.draw(gen_source,genFinal);
 	//acceptor_over.draw(accept_source,acceptFinal);
 	overapprox_detector->getGeneratorPath(genFinal,acceptFinal,path,true,true);//why is this needed?
-	static vec<bool> seen_states;
+	static thread_local vec<bool> seen_states;
 	/*seen_states.clear();
 	seen_states.growTo(g_over.states());
 	if(true||g_over.mustBeDeterministic()){
@@ -1872,7 +1872,7 @@ Lit FSMGeneratorAcceptorDetector::decide(int level) {
 		if(outer->value(l)!=l_False){
 			int gen_to = t.gen_to;
 			int accept_to = t.accept_to;
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 
 			if(overapprox_detector->getGeneratorPath(gen_to,accept_to,path,true,false)){
@@ -1905,7 +1905,7 @@ void FSMGeneratorAcceptorDetector::printSolution(std::ostream& out){
 		int accept_to = t.accept_to;
 
 		if(outer->value(l)==l_True){
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 			assert(underapprox_detector->accepts(gen_to,accept_to));
 			underapprox_detector->getGeneratorPath(gen_to,accept_to,path);
@@ -1920,7 +1920,7 @@ void FSMGeneratorAcceptorDetector::printSolution(std::ostream& out){
 			}
 			out<<"\n";
 		}else{
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 			if(g_under.generates(gen_source,gen_to, path)){
 				out<<"Generated string: ";
@@ -2003,8 +2003,8 @@ bool FSMGeneratorAcceptorDetector::acceptsSuffix(DynamicFSM & g_suffix, DynamicF
 	vec<int> next;
 	vec<int> cur;
 
-	static vec<bool> next_seen;
-	static vec<bool> cur_seen;
+	static thread_local vec<bool> next_seen;
+	static thread_local vec<bool> cur_seen;
 	cur_seen.clear();
 	next_seen.clear();
 	cur_seen.growTo(g_suffix.states());
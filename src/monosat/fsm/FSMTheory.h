@@ -223,6 +223,18 @@ public:
 	Solver * getSolver(){
 		return S;
 	}
+	void writeProfile(std::ostream& write_to) override {
+		Theory::writeProfile(write_to);
+		write_to << ",\"detectors\":[";
+		for (int i = 0; i < detectors.size(); i++) {
+			if (i > 0)
+				write_to << ",";
+			writeDetectorProfile(write_to, detectors[i]->getID(), detectors[i]->getName(), detectors[i]->stats_propagate_profile,
+					detectors[i]->stats_reason_profile);
+		}
+		write_to << "]";
+	}
+
 	void printStats(int detailLevel) override {
 		printf("FSM %d stats:\n", getGraphID());
 		if(stats_decisions>0){
@@ -495,7 +507,7 @@ public:
 	}
 
 	void backtrackUntil(int level) override {
-		static int it = 0;
+		static thread_local int it = 0;
 		
 		bool changed = false;
 		//need to remove and add edges in the two graphs accordingly.
@@ -647,7 +659,10 @@ public:
 		backtrackUntil(p);
 		
 		assert(d < detectors.size());
-		detectors[d]->buildReason(p, reason, marker);
+		{
+			ProfileScope scope(detectors[d]->stats_reason_profile);
+			detectors[d]->buildReason(p, reason, marker);
+		}
 		toSolver(reason);
 		double finish = rtime(1);
 		stats_reason_time += finish - start;
@@ -773,7 +788,7 @@ public:
 	}
 
 	bool propagateTheory(vec<Lit> & conflict, bool force_propagation) {
-		static int itp = 0;
+		static thread_local int itp = 0;
 		if (++itp == 11673) {
 			int a = 1;
 		}
@@ -807,8 +822,17 @@ public:
 		assert(dbg_graphsUpToDate());
 		
 		for (int d = 0; d < detectors.size(); d++) {
+			if(!force_propagation && S->limitReached()){
+				//Out of time or memory; leave the remaining detectors for a later round, as if this propagation had been skipped.
+				propagationtime += rtime(1) - startproptime;
+				return true;
+			}
 			assert(conflict.size() == 0);
-			bool r = detectors[d]->propagate(conflict);
+			bool r;
+			{
+				ProfileScope scope(detectors[d]->stats_propagate_profile);
+				r = detectors[d]->propagate(conflict);
+			}
 			if (!r) {
 				stats_num_conflicts++;
 				toSolver(conflict);
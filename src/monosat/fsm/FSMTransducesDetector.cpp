@@ -96,7 +96,7 @@ void FSMTransducesDetector::TransducesStatus::transduces(int string1, int string
 
 
 bool FSMTransducesDetector::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 87) {
 		int a = 1;
 	}
@@ -191,9 +191,9 @@ void FSMTransducesDetector::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 }
 
 void FSMTransducesDetector::buildTransducesReason(int node,int str1,int str2, vec<Lit> & conflict){
-	static int iter = 0;
+	static thread_local int iter = 0;
 	++iter;
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	bool hasPath =underapprox_detector->getPath(str1,str2,node,path);
 	assert(hasPath);
@@ -303,14 +303,14 @@ bool FSMTransducesDetector::path_rec(int s, int dest,int string1,int string2,int
 }
 
 void FSMTransducesDetector::buildNonTransducesReason(int node,int str1,int str2, vec<Lit> & conflict){
-	static int iter = 0;
+	static thread_local int iter = 0;
 
 
 
 	if(++iter==10189){
 		int a=1;
 	}
-	static vec<NFATransition> ignore;
+	static thread_local vec<NFATransition> ignore;
 	ignore.clear();
 	path_rec(source,node, str1,str2,0, 0,0,ignore,conflict);
 
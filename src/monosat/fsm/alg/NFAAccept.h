@@ -279,7 +279,7 @@ public:
 			return;
 		}
 
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		stats_full_updates++;
 
@@ -0,0 +1,413 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef NFA_BIT_ACCEPT_H_
+#define NFA_BIT_ACCEPT_H_
+
+#include "monosat/fsm/alg/NFATypes.h"
+#include "monosat/fsm/alg/NFAAcceptor.h"
+#include "monosat/fsm/DynamicFSM.h"
+#include "monosat/mtl/Bitset.h"
+#include "monosat/mtl/Vec.h"
+#include <cassert>
+#include <cstdint>
+
+using namespace Monosat;
+
+/**
+ * Simulates every string through the FSM at once, bit-parallel across strings.
+ *
+ * The frontier is stored transposed: for each state, a row of words holding one bit per string, set if that state is
+ * reachable by the string's prefix read so far. A summary level holds one bit per state, set if that state's row may be
+ * non-empty, so that each step only visits occupied states. Advancing all strings by one symbol then costs one
+ * word-wise AND/OR of a row per enabled transition (masked by the strings that have that transition's symbol at the
+ * current position), rather than one pass over the FSM per string.
+ *
+ * If 'outputs' is set, strings are matched against the output labels of the transitions (as for generation),
+ * instead of the input labels.
+ */
+template<class Status=FSMNullStatus>
+class NFABitAccept: public NFAAcceptor{
+	DynamicFSM & g;
+	Status & status;
+	int source;
+	vec<vec<int>> & strings;
+	bool outputs;
+
+	int last_modification=-1;
+	int last_simulated_modification=-1;
+	int simulated_strings=-1;
+	int simulated_states=-1;
+	int simulated_edges=-1;
+	int64_t num_updates=0;
+
+	int64_t stats_simulations=0;
+	int64_t stats_skipped_updates=0;
+
+	int string_words=0;
+	int max_length=0;
+	//rows of string_words words for each state
+	vec<uint64_t> cur;
+	vec<uint64_t> next;
+	vec<uint64_t> accepted;//for each state, the strings that end in that state
+	//one bit per state: set if the corresponding row may be non-empty
+	vec<uint64_t> cur_active;
+	vec<uint64_t> next_active;
+
+	//for each position, the distinct symbols occurring at that position, and (for each of those symbols, in the same
+	//order) a row of the strings that have that symbol at that position
+	vec<vec<int>> position_symbols;
+	vec<vec<uint64_t>> position_masks;
+	//for each length, a row of the strings of that length
+	vec<uint64_t> ends_at;
+
+	vec<int> emove_queue;
+	vec<bool> in_emove_queue;
+	vec<int> symbol_index;
+
+	vec<vec<bool>> states_to_track_positive;
+	vec<vec<bool>> states_to_track_negative;
+	vec<int> n_trackingString;
+	int n_tracking=0;
+
+public:
+	NFABitAccept(DynamicFSM & f, int source, vec<vec<int>> & strings, Status & status=fsmNullStatus, bool outputs=false):
+			g(f), status(status), source(source), strings(strings), outputs(outputs){
+
+	}
+
+private:
+	static inline bool testBit(const uint64_t * row, int i){
+		return (row[i >> 6] >> (i & 63)) & 1;
+	}
+	static inline void setBit(uint64_t * row, int i){
+		row[i >> 6] |= ((uint64_t) 1) << (i & 63);
+	}
+
+	inline bool symbolEnabled(int edgeID, int label){
+		return outputs ? g.transitionEnabled(edgeID, 0, label) : g.transitionEnabled(edgeID, label, 0);
+	}
+
+	void buildStringTrackers(){
+		states_to_track_positive.growTo(strings.size());
+		states_to_track_negative.growTo(strings.size());
+		n_trackingString.growTo(strings.size(), 0);
+		for(int i = 0;i<strings.size();i++){
+			states_to_track_positive[i].growTo(g.states(), false);
+			states_to_track_negative[i].growTo(g.states(), false);
+		}
+	}
+
+	//Build the per-position symbol masks (only needs to be redone if strings are added).
+	void buildMasks(){
+		string_words = (strings.size() + 63) / 64;
+		max_length = 0;
+		for(int i = 0;i<strings.size();i++){
+			if(strings[i].size() > max_length)
+				max_length = strings[i].size();
+		}
+		int alphabet = outputs ? g.outAlphabet() : g.inAlphabet();
+		symbol_index.clear();
+		symbol_index.growTo(alphabet, -1);
+		position_symbols.clear();
+		position_symbols.growTo(max_length);
+		position_masks.clear();
+		position_masks.growTo(max_length);
+		ends_at.clear();
+		ends_at.growTo((max_length + 1) * string_words, 0);
+		for(int p = 0;p<max_length;p++){
+			vec<int> & symbols = position_symbols[p];
+			vec<uint64_t> & masks = position_masks[p];
+			for(int i = 0;i<strings.size();i++){
+				if(p >= strings[i].size())
+					continue;
+				int l = strings[i][p];
+				assert(l > 0);
+				assert(l < alphabet);
+				if(symbol_index[l] < 0){
+					symbol_index[l] = symbols.size();
+					symbols.push(l);
+					masks.growTo(symbols.size() * string_words, 0);
+				}
+				setBit(&masks[symbol_index[l] * string_words], i);
+			}
+			for(int l:symbols)
+				symbol_index[l] = -1;
+		}
+		for(int i = 0;i<strings.size();i++){
+			setBit(&ends_at[strings[i].size() * string_words], i);
+		}
+		simulated_strings = strings.size();
+	}
+
+	//Close the frontier 'rows' under enabled e-moves.
+	void closeEmoves(vec<uint64_t> & rows, vec<uint64_t> & active){
+		if(!g.emovesEnabled(!outputs))
+			return;
+		in_emove_queue.growTo(g.states(), false);
+		for(int w = 0;w<active.size();w++){
+			uint64_t bits = active[w];
+			while(bits){
+				int s = (w << 6) + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				emove_queue.push(s);
+				in_emove_queue[s] = true;
+			}
+		}
+		while(emove_queue.size()){
+			int s = emove_queue.last();
+			emove_queue.pop();
+			in_emove_queue[s] = false;
+			const uint64_t * from = &rows[s * string_words];
+			for(int j = 0;j<g.nIncident(s);j++){
+				int edgeID = g.incident(s, j).id;
+				int to = g.incident(s, j).node;
+				if(!g.transitionEnabled(edgeID, 0, 0))
+					continue;
+				uint64_t * dest = &rows[to * string_words];
+				uint64_t changed = 0;
+				for(int w = 0;w<string_words;w++){
+					uint64_t added = from[w] & ~dest[w];
+					dest[w] |= added;
+					changed |= added;
+				}
+				if(changed){
+					setBit(&active[0], to);
+					if(!in_emove_queue[to]){
+						in_emove_queue[to] = true;
+						emove_queue.push(to);
+					}
+				}
+			}
+		}
+	}
+
+	//Record the strings of length 'p' that end in each occupied state.
+	void recordAccepting(int p){
+		const uint64_t * ending = &ends_at[p * string_words];
+		for(int w = 0;w<cur_active.size();w++){
+			uint64_t bits = cur_active[w];
+			while(bits){
+				int s = (w << 6) + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				const uint64_t * row = &cur[s * string_words];
+				uint64_t * acc = &accepted[s * string_words];
+				for(int i = 0;i<string_words;i++)
+					acc[i] |= row[i] & ending[i];
+			}
+		}
+	}
+
+	//Advance every string by the symbol at position 'p'.
+	void step(int p){
+		const vec<int> & symbols = position_symbols[p];
+		const vec<uint64_t> & masks = position_masks[p];
+		for(int i = 0;i<next.size();i++)
+			next[i] = 0;
+		for(int i = 0;i<next_active.size();i++)
+			next_active[i] = 0;
+		for(int w = 0;w<cur_active.size();w++){
+			uint64_t bits = cur_active[w];
+			while(bits){
+				int s = (w << 6) + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				const uint64_t * from = &cur[s * string_words];
+				for(int j = 0;j<g.nIncident(s);j++){
+					int edgeID = g.incident(s, j).id;
+					int to = g.incident(s, j).node;
+					uint64_t * dest = &next[to * string_words];
+					for(int k = 0;k<symbols.size();k++){
+						if(!symbolEnabled(edgeID, symbols[k]))
+							continue;
+						const uint64_t * mask = &masks[k * string_words];
+						uint64_t any = 0;
+						for(int i = 0;i<string_words;i++){
+							uint64_t reached = from[i] & mask[i];
+							dest[i] |= reached;
+							any |= reached;
+						}
+						if(any)
+							setBit(&next_active[0], to);
+					}
+				}
+			}
+		}
+		next.swap(cur);
+		next_active.swap(cur_active);
+	}
+
+	void simulate(){
+		stats_simulations++;
+		if(simulated_strings != strings.size())
+			buildMasks();
+		int n = g.states();
+		int state_words = (n + 63) / 64;
+		cur.clear();
+		cur.growTo(n * string_words, 0);
+		next.clear();
+		next.growTo(n * string_words, 0);
+		accepted.clear();
+		accepted.growTo(n * string_words, 0);
+		cur_active.clear();
+		cur_active.growTo(state_words, 0);
+		next_active.clear();
+		next_active.growTo(state_words, 0);
+
+		if(strings.size()){
+			uint64_t * start = &cur[source * string_words];
+			for(int i = 0;i<strings.size();i++)
+				setBit(start, i);
+			setBit(&cur_active[0], source);
+			closeEmoves(cur, cur_active);
+			recordAccepting(0);
+			for(int p = 0;p<max_length;p++){
+				step(p);
+				closeEmoves(cur, cur_active);
+				recordAccepting(p + 1);
+			}
+		}
+		last_simulated_modification = g.modifications;
+		simulated_states = n;
+		simulated_edges = g.edges();
+	}
+
+	void ensureSimulated(){
+		if(last_simulated_modification <= 0 || last_simulated_modification != g.modifications
+		   || simulated_strings != strings.size() || simulated_states != g.states() || simulated_edges != g.edges())
+			simulate();
+	}
+
+	bool path_rec(int s, int dest, int string, int str_pos, int emove_count, vec<NFATransition> & path){
+		if(str_pos==strings[string].size() && (s==dest || dest<0)){
+			return true;
+		}
+		if (emove_count>=g.states()){
+			return false;//avoid infinite e-move cycles
+		}
+		for(int j = 0;j<g.nIncident(s);j++){
+			int edgeID= g.incident(s,j).id;
+			int to = g.incident(s,j).node;
+			if(g.transitionEnabled(edgeID,0,0)){
+				path.push({edgeID,0,0});
+				if(path_rec(to,dest,string,str_pos,emove_count+1,path)){
+					return true;
+				}else{
+					path.pop();
+				}
+			}
+			if(str_pos< strings[string].size()){
+				int l = strings[string][str_pos];
+				if(symbolEnabled(edgeID,l)){
+					if(outputs)
+						path.push({edgeID,0,l});
+					else
+						path.push({edgeID,l,0});
+					if(path_rec(to,dest,string,str_pos+1,0,path)){
+						return true;
+					}else{
+						path.pop();
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+public:
+	void setTrackStringAcceptance(int str, int state, bool trackPositiveAcceptance, bool trackNegativeAcceptance) override{
+		buildStringTrackers();
+		bool was_tracked = states_to_track_positive[str][state] || states_to_track_negative[str][state];
+		states_to_track_positive[str][state]=trackPositiveAcceptance;
+		states_to_track_negative[str][state]=trackNegativeAcceptance;
+		bool tracked = trackPositiveAcceptance || trackNegativeAcceptance;
+		if(tracked != was_tracked){
+			n_trackingString[str] += tracked ? 1 : -1;
+			n_tracking += tracked ? 1 : -1;
+		}
+	}
+
+	int numUpdates() const override{
+		return num_updates;
+	}
+
+	void update() override{
+		if (last_modification > 0 && g.modifications == last_modification) {
+			stats_skipped_updates++;
+			return;
+		}
+		if(n_tracking==0){
+			stats_skipped_updates++;
+			return;
+		}
+		ensureSimulated();
+		for(int str = 0;str<strings.size();str++){
+			if(str>=n_trackingString.size() || n_trackingString[str]==0)
+				continue;
+			for(int s = 0;s<g.states();s++){
+				status.accepts(str,s,-1,-1,testBit(&accepted[s * string_words],str));
+			}
+		}
+		num_updates++;
+		last_modification = g.modifications;
+	}
+
+	//If state is -1, then this is true if any state accepts the string.
+	bool acceptsString(int string, int state) override{
+		ensureSimulated();
+		if(state>=0)
+			return testBit(&accepted[state * string_words],string);
+		for(int s = 0;s<g.states();s++){
+			if(testBit(&accepted[s * string_words],string))
+				return true;
+		}
+		return false;
+	}
+
+	bool getPath(int string, int state, vec<NFATransition> & path) override{
+		return path_rec(source,state,string,0,0,path);
+	}
+
+	vec<Bitset> used_transition;
+	bool getAbstractPath(int string, int state, vec<NFATransition> &path, bool reversed) override{
+		update();
+		getPath(string,state,path);
+		used_transition.growTo(g.edges());
+		int i,j=0;
+		for(i = 0;i<path.size();i++){
+			NFATransition & t = path[i];
+			int l = outputs ? t.output : t.input;
+			used_transition[t.edgeID].growTo((outputs ? g.outAlphabet() : g.inAlphabet())+1);
+			if(!used_transition[t.edgeID][l]) {
+				path[j++]=t;
+				used_transition[t.edgeID].set(l);
+			}
+		}
+		path.shrink(i-j);
+		for(NFATransition & t:path){
+			used_transition[t.edgeID].clear(outputs ? t.output : t.input);
+		}
+		if(reversed)
+			reverse(path);
+		return true;
+	}
+};
+
+#endif /* NFA_BIT_ACCEPT_H_ */
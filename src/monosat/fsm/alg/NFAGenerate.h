@@ -11,6 +11,7 @@
 #include "monosat/mtl/Bitset.h"
 #include "monosat/mtl/Vec.h"
 #include "monosat/fsm/alg/NFATypes.h"
+#include "monosat/fsm/alg/NFABitAccept.h"
 
 using namespace Monosat;
 
@@ -47,11 +48,21 @@ class NFAGenerate{
 	int source;
 	vec<vec<int>> & strings;
 
-
+	//Optional bit-parallel simulation of all strings over the output labels.
+	//A string with no path at all cannot have a unique generating path, so this rules out most non-generated strings
+	//without running the (much more expensive) unique path search on them.
+	NFABitAccept<> * prefilter=nullptr;
 
 public:
-	NFAGenerate(DynamicFSM & f,int source, vec<vec<int>> & strings,Status & status=fsmNullStatus):g(f),status(status),source(source),strings(strings){
-
+	NFAGenerate(DynamicFSM & f,int source, vec<vec<int>> & strings,Status & status=fsmNullStatus, bool bitParallelFilter=false):g(f),status(status),source(source),strings(strings){
+		if(bitParallelFilter){
+			prefilter = new NFABitAccept<>(f,source,strings,fsmNullStatus,true);
+		}
+	}
+	~NFAGenerate(){
+		if(prefilter){
+			delete prefilter;
+		}
 	}
 
 private:
@@ -141,7 +152,7 @@ public:
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		stats_full_updates++;
 
@@ -156,7 +167,9 @@ public:
 			cur_seen.growTo(g.states());
 		}
 		for(int i = 0;i<strings.size();i++){
-			if(generatesString(i)){
+			if(prefilter && !prefilter->acceptsString(i,-1)){
+				status.generates(i,false);
+			}else if(generatesString(i)){
 				status.generates(i,true);
 			}else{
 				status.generates(i,false);
@@ -198,7 +211,7 @@ public:
 
 	//inefficient!
 	bool generatesString(int string){
-		static vec<NFATransition> ignore;
+		static thread_local vec<NFATransition> ignore;
 		ignore.clear();
 		return getPath(string, ignore);
 	}
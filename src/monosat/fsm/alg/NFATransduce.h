@@ -225,7 +225,7 @@ public:
 			stats_skipped_updates++;
 			return;
 		}
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		stats_full_updates++;
 
@@ -286,7 +286,7 @@ public:
 	//inefficient!
 	//If state is -1, then this is true if any state accepts the string.
 	bool transducesString(int string1,int string2, int state){
-		static vec<NFATransition> ignore;
+		static thread_local vec<NFATransition> ignore;
 		ignore.clear();
 		return getPath(string1,string2,state,ignore);
 		/*run(string1);
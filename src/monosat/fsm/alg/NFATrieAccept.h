@@ -0,0 +1,386 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef NFA_TRIE_ACCEPT_H_
+#define NFA_TRIE_ACCEPT_H_
+
+#include "monosat/fsm/alg/NFATypes.h"
+#include "monosat/fsm/alg/NFAAcceptor.h"
+#include "monosat/fsm/DynamicFSM.h"
+#include "monosat/mtl/Bitset.h"
+#include "monosat/mtl/Vec.h"
+#include <cassert>
+#include <cstdint>
+
+using namespace Monosat;
+
+/**
+ * Checks acceptance of a set of strings that are organized into a trie, so that strings with common prefixes share
+ * their simulation up to the end of that prefix.
+ *
+ * Each trie node caches the set of states reachable (after e-moves) by reading the prefix that leads to it.
+ * When transitions are enabled or disabled, only the trie nodes whose cached set could be affected are recomputed:
+ * a changed e-move from state u only affects nodes whose set contains u, and a changed transition from u on label l only
+ * affects the children (on l) of nodes whose set contains u. If a recomputed set is unchanged, its subtree is left alone;
+ * otherwise, all of its children are recomputed as well.
+ */
+template<class Status=FSMNullStatus>
+class NFATrieAccept: public NFAAcceptor{
+	DynamicFSM & g;
+	Status & status;
+	int source;
+	vec<vec<int>> & strings;
+
+	int last_modification=-1;
+	int history_qhead=0;
+	int last_history_clear=-1;
+	int last_states=-1;
+	int last_edges=-1;
+	int64_t num_updates=0;
+
+	int64_t stats_full_updates=0;
+	int64_t stats_fast_updates=0;
+	int64_t stats_skipped_updates=0;
+	int64_t stats_recomputed_nodes=0;
+
+	struct TrieNode{
+		int parent=-1;
+		int label=0;
+		vec<int> children;
+	};
+	vec<TrieNode> trie;
+	//the trie node reached by each string
+	vec<int> string_node;
+
+	int state_words=0;
+	//for each trie node, a row of state_words words, holding the states reachable by that node's prefix
+	vec<uint64_t> frontiers;
+	vec<uint64_t> scratch;
+	vec<bool> dirty;
+	vec<bool> recomputed;
+
+	//transitions changed since the last update
+	vec<uint64_t> changed_emove_sources;
+	struct LabelChange{
+		int from;
+		int label;
+	};
+	vec<LabelChange> changed_transitions;
+	vec<int> emove_queue;
+
+	vec<vec<bool>> states_to_track_positive;
+	vec<vec<bool>> states_to_track_negative;
+	vec<int> n_trackingString;
+	int n_tracking=0;
+
+public:
+	NFATrieAccept(DynamicFSM & f, int source, vec<vec<int>> & strings, Status & status=fsmNullStatus):
+			g(f), status(status), source(source), strings(strings){
+		trie.push();//root
+	}
+
+private:
+	static inline bool testBit(const uint64_t * row, int i){
+		return (row[i >> 6] >> (i & 63)) & 1;
+	}
+	static inline void setBit(uint64_t * row, int i){
+		row[i >> 6] |= ((uint64_t) 1) << (i & 63);
+	}
+
+	void buildStringTrackers(){
+		states_to_track_positive.growTo(strings.size());
+		states_to_track_negative.growTo(strings.size());
+		n_trackingString.growTo(strings.size(), 0);
+		for(int i = 0;i<strings.size();i++){
+			states_to_track_positive[i].growTo(g.states(), false);
+			states_to_track_negative[i].growTo(g.states(), false);
+		}
+	}
+
+	//Insert any strings that are not yet in the trie, marking new trie nodes dirty.
+	void insertStrings(){
+		for(int str = string_node.size();str<strings.size();str++){
+			int node = 0;
+			for(int l:strings[str]){
+				int child = -1;
+				for(int c:trie[node].children){
+					if(trie[c].label == l){
+						child = c;
+						break;
+					}
+				}
+				if(child < 0){
+					child = trie.size();
+					trie.push();
+					trie[child].parent = node;
+					trie[child].label = l;
+					trie[node].children.push(child);
+				}
+				node = child;
+			}
+			string_node.push(node);
+		}
+		//children are always created after their parents, so trie node order is a topological order
+		frontiers.growTo(trie.size() * state_words, 0);
+		dirty.growTo(trie.size(), true);
+		recomputed.growTo(trie.size(), false);
+	}
+
+	//Close the states in 'row' under enabled e-moves.
+	void closeEmoves(uint64_t * row){
+		if(!g.emovesEnabled())
+			return;
+		for(int w = 0;w<state_words;w++){
+			uint64_t bits = row[w];
+			while(bits){
+				emove_queue.push((w << 6) + __builtin_ctzll(bits));
+				bits &= bits - 1;
+			}
+		}
+		while(emove_queue.size()){
+			int s = emove_queue.last();
+			emove_queue.pop();
+			for(int j = 0;j<g.nIncident(s);j++){
+				int edgeID = g.incident(s, j).id;
+				int to = g.incident(s, j).node;
+				if(g.transitionEnabled(edgeID, 0, 0) && !testBit(row, to)){
+					setBit(row, to);
+					emove_queue.push(to);
+				}
+			}
+		}
+	}
+
+	//Recompute the frontier of trie node 'node' from its parent's, returning true if it changed.
+	bool recompute(int node){
+		stats_recomputed_nodes++;
+		for(int w = 0;w<state_words;w++)
+			scratch[w] = 0;
+		if(node == 0){
+			setBit(&scratch[0], source);
+		}else{
+			int label = trie[node].label;
+			const uint64_t * from = &frontiers[trie[node].parent * state_words];
+			for(int w = 0;w<state_words;w++){
+				uint64_t bits = from[w];
+				while(bits){
+					int s = (w << 6) + __builtin_ctzll(bits);
+					bits &= bits - 1;
+					for(int j = 0;j<g.nIncident(s);j++){
+						int edgeID = g.incident(s, j).id;
+						int to = g.incident(s, j).node;
+						if(g.transitionEnabled(edgeID, label, 0))
+							setBit(&scratch[0], to);
+					}
+				}
+			}
+		}
+		closeEmoves(&scratch[0]);
+		uint64_t * row = &frontiers[node * state_words];
+		bool changed = false;
+		for(int w = 0;w<state_words;w++){
+			if(row[w] != scratch[w]){
+				changed = true;
+				row[w] = scratch[w];
+			}
+		}
+		return changed;
+	}
+
+	//Returns true if a transition that changed since the last update could affect this node's frontier.
+	bool affectedByChanges(int node){
+		const uint64_t * row = &frontiers[node * state_words];
+		for(int w = 0;w<state_words;w++){
+			if(row[w] & changed_emove_sources[w])
+				return true;
+		}
+		if(node > 0 && changed_transitions.size()){
+			const uint64_t * parent = &frontiers[trie[node].parent * state_words];
+			for(auto & c:changed_transitions){
+				if(c.label == trie[node].label && testBit(parent, c.from))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	void refresh(){
+		insertStrings();
+		bool full = last_modification <= 0 || last_states != g.states() || last_edges != g.edges()
+					|| last_history_clear != g.historyclears || history_qhead > g.history.size();
+		if(full){
+			stats_full_updates++;
+			state_words = (g.states() + 63) / 64;
+			frontiers.clear();
+			frontiers.growTo(trie.size() * state_words, 0);
+			scratch.growTo(state_words);
+			for(int i = 0;i<trie.size();i++)
+				recompute(i);
+			for(int i = 0;i<dirty.size();i++)
+				dirty[i] = false;
+		}else{
+			stats_fast_updates++;
+			changed_emove_sources.clear();
+			changed_emove_sources.growTo(state_words, 0);
+			changed_transitions.clear();
+			for(int i = history_qhead;i<g.history.size();i++){
+				DynamicFSM::EdgeChange & c = g.history[i];
+				if(c.output != 0)
+					continue;
+				int from = g.getEdge(c.id).from;
+				if(c.input == 0){
+					setBit(&changed_emove_sources[0], from);
+				}else{
+					changed_transitions.push({from, c.input});
+				}
+			}
+			scratch.growTo(state_words);
+			for(int i = 0;i<trie.size();i++){
+				recomputed[i] = false;
+				bool parent_changed = i > 0 && recomputed[trie[i].parent];
+				if(dirty[i] || parent_changed || affectedByChanges(i)){
+					dirty[i] = false;
+					recomputed[i] = recompute(i);
+				}
+			}
+		}
+		last_modification = g.modifications;
+		last_states = g.states();
+		last_edges = g.edges();
+		history_qhead = g.history.size();
+		last_history_clear = g.historyclears;
+	}
+
+	bool path_rec(int s, int dest, int string, int str_pos, int emove_count, vec<NFATransition> & path){
+		if(str_pos==strings[string].size() && (s==dest || dest<0)){
+			return true;
+		}
+		if (emove_count>=g.states()){
+			return false;//avoid infinite e-move cycles
+		}
+		for(int j = 0;j<g.nIncident(s);j++){
+			int edgeID= g.incident(s,j).id;
+			int to = g.incident(s,j).node;
+			if(g.transitionEnabled(edgeID,0,0)){
+				path.push({edgeID,0,0});
+				if(path_rec(to,dest,string,str_pos,emove_count+1,path)){
+					return true;
+				}else{
+					path.pop();
+				}
+			}
+			if(str_pos< strings[string].size()){
+				int l = strings[string][str_pos];
+				if(g.transitionEnabled(edgeID,l,0)){
+					path.push({edgeID,l,0});
+					if(path_rec(to,dest,string,str_pos+1,0,path)){
+						return true;
+					}else{
+						path.pop();
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+public:
+	void setTrackStringAcceptance(int str, int state, bool trackPositiveAcceptance, bool trackNegativeAcceptance) override{
+		buildStringTrackers();
+		bool was_tracked = states_to_track_positive[str][state] || states_to_track_negative[str][state];
+		states_to_track_positive[str][state]=trackPositiveAcceptance;
+		states_to_track_negative[str][state]=trackNegativeAcceptance;
+		bool tracked = trackPositiveAcceptance || trackNegativeAcceptance;
+		if(tracked != was_tracked){
+			n_trackingString[str] += tracked ? 1 : -1;
+			n_tracking += tracked ? 1 : -1;
+		}
+	}
+
+	int numUpdates() const override{
+		return num_updates;
+	}
+
+	void update() override{
+		if (last_modification > 0 && g.modifications == last_modification && string_node.size() == strings.size()) {
+			stats_skipped_updates++;
+			return;
+		}
+		if(n_tracking==0){
+			stats_skipped_updates++;
+			return;
+		}
+		refresh();
+		for(int str = 0;str<strings.size();str++){
+			if(str>=n_trackingString.size() || n_trackingString[str]==0)
+				continue;
+			const uint64_t * row = &frontiers[string_node[str] * state_words];
+			for(int s = 0;s<g.states();s++){
+				if(states_to_track_positive[str][s] || states_to_track_negative[str][s])
+					status.accepts(str,s,-1,-1,testBit(row,s));
+			}
+		}
+		num_updates++;
+	}
+
+	//If state is -1, then this is true if any state accepts the string.
+	bool acceptsString(int string, int state) override{
+		if(last_modification <= 0 || g.modifications != last_modification || string_node.size() != strings.size())
+			refresh();
+		const uint64_t * row = &frontiers[string_node[string] * state_words];
+		if(state>=0)
+			return testBit(row,state);
+		for(int w = 0;w<state_words;w++){
+			if(row[w])
+				return true;
+		}
+		return false;
+	}
+
+	bool getPath(int string, int state, vec<NFATransition> & path) override{
+		return path_rec(source,state,string,0,0,path);
+	}
+
+	vec<Bitset> used_transition;
+	bool getAbstractPath(int string, int state, vec<NFATransition> &path, bool reversed) override{
+		update();
+		getPath(string,state,path);
+		used_transition.growTo(g.edges());
+		int i,j=0;
+		for(i = 0;i<path.size();i++){
+			NFATransition & t = path[i];
+			used_transition[t.edgeID].growTo(g.inAlphabet()+1);
+			if(!used_transition[t.edgeID][t.input]) {
+				path[j++]=t;
+				used_transition[t.edgeID].set(t.input);
+			}
+		}
+		path.shrink(i-j);
+		for(NFATransition & t:path){
+			used_transition[t.edgeID].clear(t.input);
+		}
+		if(reversed)
+			reverse(path);
+		return true;
+	}
+};
+
+#endif /* NFA_TRIE_ACCEPT_H_ */
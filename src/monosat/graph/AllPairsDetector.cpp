@@ -32,7 +32,7 @@ AllPairsDetector<Weight,Graph>::AllPairsDetector(int _detectorID, GraphTheorySol
 	
 	positiveReachStatus = new AllPairsDetector<Weight,Graph>::ReachStatus(*this, true);
 	negativeReachStatus = new AllPairsDetector<Weight,Graph>::ReachStatus(*this, false);
-	if (allpairsalg == AllPairsAlg::ALG_FLOYDWARSHALL) {
+	if (outer->getConfig().allpairsalg == AllPairsAlg::ALG_FLOYDWARSHALL) {
 		underapprox_reach_detector = new FloydWarshall<Weight,Graph,AllPairsDetector<Weight,Graph>::ReachStatus>(_g,
 				*(positiveReachStatus), 1);
 		overapprox_reach_detector = new FloydWarshall<Weight,Graph,AllPairsDetector<Weight,Graph>::ReachStatus>(_antig,
@@ -175,7 +175,7 @@ template<typename Weight,typename Graph>
 void AllPairsDetector<Weight,Graph>::buildReachReason(int source, int to, vec<Lit> & conflict) {
 	//drawFull();
 	AllPairs & d = *underapprox_path_detector;
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 3) {
 		int a = 1;
 	}
@@ -220,7 +220,7 @@ void AllPairsDetector<Weight,Graph>::buildReachReason(int source, int to, vec<Li
 }
 template<typename Weight,typename Graph>
 void AllPairsDetector<Weight,Graph>::buildNonReachReason(int source, int node, vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	++it;
 	int u = node;
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
@@ -513,7 +513,7 @@ Lit AllPairsDetector<Weight,Graph>::decide(CRef &decision_reason) {
 					assert(overapprox_reach_detector->distance(s, j) <= min_dist);//else we would already be in conflict before this decision was attempted!
 					if (underapprox_reach_detector->distance(s, j) > min_dist) {
 						//then lets try to connect this
-						static vec<bool> print_path;
+						static thread_local vec<bool> print_path;
 						
 						assert(overapprox_reach_detector->connected(s, j));		//Else, we would already be in conflict
 						int p = j;
@@ -208,7 +208,7 @@ void ConnectedComponentsDetector<Weight,Graph>::buildMinComponentsTooLowReason(i
 }
 template<typename Weight,typename Graph>
 void ConnectedComponentsDetector<Weight,Graph>::buildMinComponentsTooHighReason(int min_components, vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	++it;
 	
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
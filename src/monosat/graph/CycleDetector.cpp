@@ -32,14 +32,14 @@ CycleDetector<Weight,Graph>::CycleDetector(int _detectorID, GraphTheorySolver<We
 	directed_acyclic_lit = lit_Undef;
 	
 
-	if(cyclealg==CycleAlg::ALG_DFS_CYCLE){
+	if(outer->getConfig().cyclealg==CycleAlg::ALG_DFS_CYCLE){
 		underapprox_directed_cycle_detector = new DFSCycle<Weight,Graph,true,true>(g_under, detect_directed_cycles, 1);
 		overapprox_directed_cycle_detector = new DFSCycle<Weight,Graph,true,true>(g_over, detect_directed_cycles, 1);
 
 		overapprox_undirected_cycle_detector=overapprox_directed_cycle_detector;
 		underapprox_undirected_cycle_detector=underapprox_directed_cycle_detector;
 
-	}else if(cyclealg==CycleAlg::ALG_PK_CYCLE){
+	}else if(outer->getConfig().cyclealg==CycleAlg::ALG_PK_CYCLE){
 		underapprox_directed_cycle_detector = new PKToplogicalSort<Weight,Graph>(g_under,  1);
 		overapprox_directed_cycle_detector = new PKToplogicalSort<Weight,Graph>(g_over,  1);
 
@@ -183,7 +183,7 @@ void CycleDetector<Weight,Graph>::buildReason(Lit p, vec<Lit> & reason, CRef mar
 }
 template<typename Weight,typename Graph>
 bool CycleDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 
 
 	double startdreachtime = rtime(2);
@@ -25,6 +25,7 @@
 #include "GraphTheoryTypes.h"
 #include "monosat/mtl/Vec.h"
 #include "monosat/core/Config.h"
+#include "monosat/core/Profile.h"
 #include "monosat/core/Heuristic.h"
 #include <string>
 #include <cstdio>
@@ -60,6 +61,9 @@ public:
 	int64_t n_stats_vsids_decisions=0;
 	int64_t stats_under_clause_length = 0;
 	int64_t stats_over_clause_length = 0;
+	//Call counts and timings of propagate() and buildReason(), maintained by the theory (see -profile)
+	ProfileCounter stats_propagate_profile;
+	ProfileCounter stats_reason_profile;
 	Heuristic * default_heuristic=nullptr;
 	int getID() {
 		return detectorID;
@@ -99,6 +103,16 @@ public:
 	virtual bool propagate(vec<Lit> & conflict	, bool backtrackOnly, Lit & conflictLit){
 		return propagate(conflict);
 	}
+	//Detectors that return true here split their propagation into an expensive update of their graph algorithms,
+	//performed by updateApproximations(), and a cheap pass in propagate() that enqueues literals and reports conflicts.
+	//updateApproximations() may only read the graphs and the current theory assignment (modifying only state private to
+	//this detector), so that it can safely be run concurrently with other detectors' updateApproximations().
+	virtual bool supportsConcurrentUpdate(){
+		return false;
+	}
+	virtual void updateApproximations(){
+
+	}
     virtual void activateHeuristic(){
 
     }
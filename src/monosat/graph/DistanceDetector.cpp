@@ -53,7 +53,7 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 	constraintsBuilt = -1;
 	first_reach_var = var_Undef;
 	stats_pure_skipped = 0;
-	if (distalg == DistAlg::ALG_SAT) {
+	if (outer->getConfig().distalg == DistAlg::ALG_SAT) {
 		positiveReachStatus = nullptr;
 		negativeReachStatus = nullptr;
 
@@ -83,7 +83,7 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 	negativeReachStatus = new DistanceDetector<Weight,Graph>::ReachStatus(*this, false);
 	
 	//select the unweighted distance detectors
-	if (distalg == DistAlg::ALG_DISTANCE) {
+	if (outer->getConfig().distalg == DistAlg::ALG_DISTANCE) {
 		if (outer->all_edges_unit) {
 			if (!opt_encode_dist_underapprox_as_sat)
 				underapprox_unweighted_distance_detector = new UnweightedBFS<Weight,Graph,typename DistanceDetector<Weight,Graph>::ReachStatus>(from,
@@ -109,7 +109,7 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 		
 		/*	if(opt_conflict_shortest_path)
 		 reach_detectors.last()->positive_dist_detector = new Dijkstra<PositiveEdgeStatus>(from,g);*/
-	} else if (distalg == DistAlg::ALG_RAMAL_REPS) {
+	} else if (outer->getConfig().distalg == DistAlg::ALG_RAMAL_REPS) {
 		if (!opt_encode_dist_underapprox_as_sat){
 			 underapprox_unweighted_distance_detector = new UnweightedRamalReps<Weight,Graph,
 					typename DistanceDetector<Weight,Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
@@ -127,7 +127,7 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 					typename DistanceDetector<Weight,Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
 		}
 		 //new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_under, Distance<int>::nullStatus, 0);
-	} else if (distalg == DistAlg::ALG_RAMAL_REPS_BATCHED) {
+	} else if (outer->getConfig().distalg == DistAlg::ALG_RAMAL_REPS_BATCHED) {
 		if (!opt_encode_dist_underapprox_as_sat){
 			underapprox_unweighted_distance_detector = new UnweightedRamalRepsBatched<Weight,Graph,
 					typename DistanceDetector<Weight,Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
@@ -145,7 +145,7 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 					typename DistanceDetector<Weight,Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
 		}
 		//new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_under, Distance<int>::nullStatus, 0);
-	} else if (distalg == DistAlg::ALG_RAMAL_REPS_BATCHED2) {
+	} else if (outer->getConfig().distalg == DistAlg::ALG_RAMAL_REPS_BATCHED2) {
 		if (!opt_encode_dist_underapprox_as_sat){
 			underapprox_unweighted_distance_detector = new UnweightedRamalRepsBatchedUnified<Weight,Graph,
 					typename DistanceDetector<Weight,Graph>::ReachStatus>(from, g_under, *(positiveReachStatus), 0);
@@ -183,17 +183,17 @@ DistanceDetector<Weight,Graph>::DistanceDetector(int _detectorID, GraphTheorySol
 	
 
 	if (opt_conflict_min_cut) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
 			
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
 			if (opt_use_kt_for_conflicts) {
 				conflict_flow = new KohliTorr<Weight>(cutGraph, source, 0,
 						opt_kt_preserve_order);
@@ -618,7 +618,7 @@ void DistanceDetector<Weight,Graph>::buildUnweightedDistanceLEQReason(int node,
 }
 template<typename Weight,typename Graph>
 void DistanceDetector<Weight,Graph>::buildUnweightedDistanceGTReason(int node, int within_steps, vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	stats_unweighted_gt_reasons++;
 	stats_over_conflicts++;
 	double starttime = rtime(2);
@@ -826,7 +826,7 @@ bool DistanceDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
 	if (!underapprox_unweighted_distance_detector)
 		return true;
 	
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 1722) { //18303
 		int a = 1;
 	}
@@ -247,6 +247,18 @@ public:
 
 	void preprocess() override;
 	bool propagate(vec<Lit> & conflict) override;
+	bool supportsConcurrentUpdate() override {
+		return true;
+	}
+	void updateApproximations() override {
+		//same conditions as in propagate(), which will then find both approximations already up to date
+		if (!underapprox_unweighted_distance_detector)
+			return;
+		if (!opt_detect_pure_theory_lits || unassigned_positives > 0)
+			underapprox_unweighted_distance_detector->update();
+		if (!opt_detect_pure_theory_lits || unassigned_negatives > 0)
+			overapprox_unweighted_distance_detector->update();
+	}
 	void buildUnweightedDistanceLEQReason(int node, vec<Lit> & conflict);
 	void buildUnweightedDistanceGTReason(int node, int within_steps, vec<Lit> & conflict);
 
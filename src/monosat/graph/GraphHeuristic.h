@@ -53,7 +53,7 @@ public:
     }
 
     Lit decideTheory(CRef &decision_reason) override {
-        static int iter = 0;
+        static thread_local int iter = 0;
         if(++iter==67749){
             int a=1;
         };
@@ -61,7 +61,7 @@ public:
 
             //first, give the main graph theory a chance to make a decision
         outer->dbg_full_sync();
-        if (opt_lazy_backtrack && outer->supportsLazyBacktracking() && opt_lazy_backtrack_decisions &&
+        if (outer->getConfig().lazy_backtrack && outer->supportsLazyBacktracking() && outer->getConfig().lazy_backtrack_decisions &&
             outer->detectors.size()) {//the detectors.size() check is a hack, to prevent empty graphs from forcing the decisions that they didn't originally contribute to.
             //assert(n_decisions<=decisionLevel());
             //printf("g%d lazy dec start: decisionLevel %d, decisions %d\n", this->id, decisionLevel(),n_decisions);
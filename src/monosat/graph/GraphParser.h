@@ -595,7 +595,7 @@ private:
 		//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 		++in;
-		static vec<char> tmp;
+		static thread_local vec<char> tmp;
 		int graphID = parseInt(in);
 		int from = parseInt(in);
 		int to = parseInt(in);
@@ -632,7 +632,7 @@ private:
 		//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 		++in;
-		static vec<char> tmp;
+		static thread_local vec<char> tmp;
 		int graphID = parseInt(in);
 		int from = parseInt(in);
 		int to = parseInt(in);
@@ -698,7 +698,7 @@ private:
 			//distance_lt grachID u w var dist is a reach query: var is true if can u reach w in graph g, false otherwise
 
 			++in;
-			static vec<char> tmp;
+			static thread_local vec<char> tmp;
 			int graphID = parseInt(in);
 			int reachVar = parseInt(in) - 1;
 
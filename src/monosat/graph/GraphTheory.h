@@ -28,6 +28,7 @@
 #include "monosat/dgl/Reach.h"
 #include "monosat/dgl/Dijkstra.h"
 #include "monosat/dgl/BFS.h"
+#include "monosat/dgl/MultiSourceBFS.h"
 
 #include "monosat/core/SolverTypes.h"
 #include "monosat/mtl/Map.h"
@@ -46,6 +47,7 @@
 #include "monosat/graph/GraphTheoryTypes.h"
 #include "monosat/utils/System.h"
 #include "monosat/core/Solver.h"
+#include "monosat/core/WorkerPool.h"
 
 #include "monosat/graph/AllPairsDetector.h"
 #include "monosat/graph/ReachDetector.h"
@@ -457,7 +459,7 @@ public:
 		}
 	void dbg_check_trail(int lev){
 #ifdef DEBUG_GRAPH
-		static vec<bool> seen;
+		static thread_local vec<bool> seen;
 		seen.clear();
 		seen.growTo(vars.size());
 		if(lev>=0){
@@ -483,7 +485,7 @@ public:
 
 			Var decision = lazy_trail_head;
 			if(decision!=var_Undef){
-				assert(opt_lazy_backtrack && supportsLazyBacktracking());
+				assert(S->config.lazy_backtrack && supportsLazyBacktracking());
 				seen[decision]=true;
 				assert(trail[decision].level==lev);
 				Var v = trail[decision].next_var;
@@ -528,7 +530,7 @@ public:
 				assert(l<decisions.size());
 				assert(decisions[l]!=var_Undef);
 			}else if (l==-2){
-				assert(opt_lazy_backtrack && supportsLazyBacktracking());
+				assert(S->config.lazy_backtrack && supportsLazyBacktracking());
 				assert(lazy_trail_head!=var_Undef);
 			}
 		}
@@ -560,6 +562,14 @@ public:
 	vec<Theory*> theories;
 	vec<bool> satisfied_detectors;
 	vec<Detector*> detectors;
+	//Reachability from all sources at once, shared by the reach detectors (if reachalg==ALG_BFS_MULTI)
+	MultiSourceBFS<Weight> * multi_reach_under = nullptr;
+	MultiSourceBFS<Weight> * multi_reach_over = nullptr;
+	MultiSourceBFS<Weight,DynamicBackGraph<Weight>> * multi_reach_under_back = nullptr;
+	MultiSourceBFS<Weight,DynamicBackGraph<Weight>> * multi_reach_over_back = nullptr;
+	//Used to update detectors concurrently (if opt_graph_prop_threads>1)
+	WorkerPool * detector_pool = nullptr;
+	vec<Detector*> concurrent_detectors;
 	vec<ReachDetector<Weight>*> reach_detectors;
     vec<ReachDetector<Weight,DynamicBackGraph<Weight>>*> reach_back_detectors;
 	vec<DistanceDetector<Weight>*> distance_detectors;
@@ -686,6 +696,7 @@ public:
 	int64_t stats_pure_skipped = 0;
 	int64_t stats_mc_calls = 0;
 	int64_t stats_propagations_skipped = 0;
+	int64_t stats_concurrent_updates = 0;
 
 	int64_t stats_lazy_decisions = 0;
 	vec<Lit> reach_cut;
@@ -828,6 +839,18 @@ public:
     }
 
 
+	void writeProfile(std::ostream& write_to) override {
+		Theory::writeProfile(write_to);
+		write_to << ",\"detectors\":[";
+		for (int i = 0; i < detectors.size(); i++) {
+			if (i > 0)
+				write_to << ",";
+			writeDetectorProfile(write_to, detectors[i]->getID(), detectors[i]->getName(), detectors[i]->stats_propagate_profile,
+					detectors[i]->stats_reason_profile);
+		}
+		write_to << "]";
+	}
+
 	void printStats(int detailLevel) override {
 
 
@@ -848,6 +871,10 @@ public:
 				g_under.skipped_historyclears, cutGraph.skipped_historyclears);
 		printf("Propagations: %" PRId64 " (%f s, avg: %f s, %" PRId64 " skipped)\n", stats_propagations, propagationtime,
 				(propagationtime) / ((double) stats_propagations + 1), stats_propagations_skipped);
+		if (opt_graph_prop_threads > 1) {
+			printf("Concurrent detector updates: %" PRId64 " (%d threads)\n", stats_concurrent_updates,
+				   (int) opt_graph_prop_threads);
+		}
 		printf("Decisions: %" PRId64 " (%f s, avg: %f s), lazy decisions: %" PRId64 "\n", stats_decisions, stats_decision_time,
 				(stats_decision_time) / ((double) stats_decisions + 1), stats_lazy_decisions);
 		printf("Conflicts: %" PRId64 " (lazy conflicts %" PRId64 ")\n", stats_num_conflicts,stats_num_lazy_conflicts);
@@ -1338,7 +1365,30 @@ public:
 	};
 
 	~GraphTheorySolver() override {
-
+		if (detector_pool) {
+			delete detector_pool;
+			detector_pool = nullptr;
+		}
+		delete multi_reach_under;
+		delete multi_reach_over;
+		delete multi_reach_under_back;
+		delete multi_reach_over_back;
+	}
+
+	//Returns the multi-source reachability shared by all reach detectors over the given graph (creating it if needed)
+	MultiSourceBFS<Weight> & getMultiSourceReach(DynamicGraph<Weight> & g){
+		assert(&g == &g_under || &g == &g_over);
+		MultiSourceBFS<Weight> *& shared = (&g == &g_under) ? multi_reach_under : multi_reach_over;
+		if (!shared)
+			shared = new MultiSourceBFS<Weight>(g);
+		return *shared;
+	}
+	MultiSourceBFS<Weight,DynamicBackGraph<Weight>> & getMultiSourceReach(DynamicBackGraph<Weight> & g){
+		assert(&g == &g_under_back || &g == &g_over_back);
+		MultiSourceBFS<Weight,DynamicBackGraph<Weight>> *& shared = (&g == &g_under_back) ? multi_reach_under_back : multi_reach_over_back;
+		if (!shared)
+			shared = new MultiSourceBFS<Weight,DynamicBackGraph<Weight>>(g);
+		return *shared;
 	}
 	void setNodeName(int node,const std::string & symbol){
 		if(hasNamedNode(symbol)){
@@ -1439,7 +1489,7 @@ public:
 
 	bool dbg_propgation(Lit l) {
 #ifdef DEBUG_GRAPH
-		static vec<Lit> c;
+		static thread_local vec<Lit> c;
 		c.clear();
 		for (int i = 0; i < S->trail.size(); i++) {
 			if (!S->hasTheory(S->trail[i]) || S->theoryHasVar(var(S->trail[i]),this) != getTheoryIndex())
@@ -1540,7 +1590,7 @@ public:
 
 	//vec<Lit> to_reenqueue;
 	void backtrackUntil(int untilLevel) override {
-		static int it = 0;
+		static thread_local int it = 0;
 		++it;
 		undoRewind();
 
@@ -1655,7 +1705,7 @@ public:
 
 
 	void backtrackUntil(Lit p) {
-		static int it=0;
+		static thread_local int it=0;
 		++it;
 		undoRewind();
 		//printf("g%d : backtrack until lit %d\n", this->id,dimacs(p));
@@ -1822,13 +1872,13 @@ public:
 		if (!opt_decide_theories)
 			return lit_Undef;
 		double start = rtime(1);
-		static int iter = 0;
+		static thread_local int iter = 0;
 		iter++;
 
 
 
         //dbg_full_sync();
-		if(opt_lazy_backtrack && supportsLazyBacktracking() && opt_lazy_backtrack_decisions && detectors.size()){//the detectors.size() check is a hack, to prevent empty graphs from forcing the decisions that they didn't originally contribute to.
+		if(S->config.lazy_backtrack && supportsLazyBacktracking() && S->config.lazy_backtrack_decisions && detectors.size()){//the detectors.size() check is a hack, to prevent empty graphs from forcing the decisions that they didn't originally contribute to.
 			//assert(n_decisions<=decisionLevel());
 			//printf("g%d lazy dec start: decisionLevel %d, decisions %d\n", this->id, decisionLevel(),n_decisions);
 			//when redeciding a literal, should check to see whether it would still be recomended as a decision by its detector...
@@ -1929,7 +1979,7 @@ public:
 
 
 	void buildBVReason(int bvID, Comparison comp, Weight compareTo, vec<Lit> &reason){
-		static int iter = 0;
+		static thread_local int iter = 0;
 		//todo: optimize this for case where bv is statically known to satisfy or fail the constraint...
 		BitVector<Weight> bv = bvTheory->getBV(bvID);
 		Lit c = getBV_COMP(bvID,-comp,compareTo);
@@ -1962,7 +2012,10 @@ public:
 			backtrackUntil(p);
 
 			assert(d < detectors.size());
-			detectors[d]->buildReason(p, reason, marker);
+			{
+				ProfileScope scope(detectors[d]->stats_reason_profile);
+				detectors[d]->buildReason(p, reason, marker);
+			}
 			//toSolver(reason);
 			double finish = rtime(1);
 			stats_reason_time += finish - start;
@@ -2089,6 +2142,14 @@ public:
 		for (int i = 0; i < detectors.size(); i++) {
 			detectors[i]->preprocess();
 		}
+		if(opt_graph_compact){
+			//all edges are normally declared by now; if any more are added later, these will expand again as needed
+			g_under.compact();
+			g_over.compact();
+			g_under_weights_over.compact();
+			g_over_weights_under.compact();
+			cutGraph.compact();
+		}
 		/*g_under.clearHistory(true);
 		g_over.clearHistory(true);
 		g_under_weights_over.clearHistory(true);
@@ -2098,7 +2159,7 @@ public:
 		g_over.clearChanged();
 		cutGraph.clearChanged();*/
 
-		if(opt_lazy_backtrack){
+		if(S->config.lazy_backtrack){
 			lazy_backtracking_enabled=true;
 			//currently, lazy backtracking is only supported if _all_ property lits are ground.
 			for (Detector * d:detectors){
@@ -2218,7 +2279,7 @@ public:
 		Var v = var(l);
 		stats_enqueues++;
 		int lev = level(v);//level from the SAT solver.
-		if(!opt_lazy_backtrack){
+		if(!S->config.lazy_backtrack){
 			assert(decisionLevel() <= lev);
 		}
 
@@ -2239,8 +2300,8 @@ public:
 			appendToTrail(l,decisionLevel());
 			}
 			return;
-		}else if (opt_lazy_backtrack && value(v)!=l_Undef){
-			if(!opt_lazy_backtrack){
+		}else if (S->config.lazy_backtrack && value(v)!=l_Undef){
+			if(!S->config.lazy_backtrack){
 				assert(decisionLevel() <= lev);
 				if(decisionLevel() > lev){
 					throw std::runtime_error("Internal error in graph enqueue");
@@ -2281,7 +2342,7 @@ public:
 			}
 			removeFromTrail(var(l));
 		}
-		if(!opt_lazy_backtrack){
+		if(!S->config.lazy_backtrack){
 			assert(decisionLevel() <= lev);
 			if(decisionLevel() > lev){
 				throw std::runtime_error("Internal error in graph enqueue");
@@ -2408,6 +2469,28 @@ public:
 	bool propagateTheory(vec<Lit> & conflict) override {
 		return propagateTheory(conflict,false);
 	}
+
+	/**
+	 * Update the graph algorithms of all unsatisfied detectors that support it in parallel, ahead of propagation.
+	 * The graphs do not change during this phase, and the detectors only read them (and the current assignment).
+	 * The detectors then enqueue literals and report conflicts one at a time, in their usual order, so propagation
+	 * produces the same results as it would if each detector had updated itself.
+	 */
+	void updateDetectorsConcurrently() {
+		concurrent_detectors.clear();
+		for (int d = 0; d < detectors.size(); d++) {
+			if (!satisfied_detectors[d] && detectors[d]->supportsConcurrentUpdate())
+				concurrent_detectors.push(detectors[d]);
+		}
+		if (concurrent_detectors.size() < opt_graph_prop_min_detectors)
+			return;//not worth the synchronization; these detectors will just update themselves when they propagate
+		if (!detector_pool)
+			detector_pool = new WorkerPool(opt_graph_prop_threads);
+		stats_concurrent_updates++;
+		detector_pool->run(concurrent_detectors.size(), [this](int i) {
+			concurrent_detectors[i]->updateApproximations();
+		});
+	}
     Heuristic * conflictingHeuristic=nullptr;
 
 	Heuristic * getConflictingHeuristic()override{
@@ -2442,7 +2525,7 @@ public:
 #endif*/
 
 
-		static int itp = 0;
+		static thread_local int itp = 0;
 		if (++itp == 33) {
 			int a = 1;
 		}
@@ -2460,7 +2543,7 @@ public:
 
 		propagations++;
 
-		if (!force_propagation && (propagations % opt_graph_prop_skip != 0)){
+		if (!force_propagation && (propagations % S->config.graph_prop_skip != 0)){
 			stats_propagations_skipped++;
 
 			return true;
@@ -2474,7 +2557,7 @@ public:
 		}
 		S->theoryPropagated(this);
 
-		if (opt_lazy_backtrack &&
+		if (S->config.lazy_backtrack &&
 				!lazy_backtracking_enabled && decisionLevel()==0 ){
 			lazy_backtracking_enabled=true;
 			//currently, lazy backtracking is only supported if _all_ property lits are ground.
@@ -2525,13 +2608,27 @@ public:
 		//dbg_sync();
 		assert(dbg_graphsUpToDate());
 
+		if (opt_graph_prop_threads > 1) {
+			updateDetectorsConcurrently();
+		}
+
 		for (int d = 0; d < detectors.size(); d++) {
 				if(satisfied_detectors[d])
 					continue;
+			if(!force_propagation && S->limitReached()){
+				//Out of time or memory (a single detector, eg. a large maxflow, can be expensive). Leave the remaining detectors
+				//for a later round, as if this propagation had been skipped; the solver will give up before its next decision.
+				propagationtime += rtime(1) - startproptime;
+				return true;
+			}
 			assert(conflict.size() == 0);
 			Lit l = lit_Undef;
 			bool backtrackOnly = lazy_backtracking_enabled && (opt_lazy_conflicts==3) &&  lazy_trail_head!=var_Undef;
-			bool r = detectors[d]->propagate(conflict,backtrackOnly,l);
+			bool r;
+			{
+				ProfileScope scope(detectors[d]->stats_propagate_profile);
+				r = detectors[d]->propagate(conflict,backtrackOnly,l);
+			}
 			if(!r && backtrackOnly && conflict.size()==0){
 				backtrackUntil(decisionLevel());
 				stats_num_lazy_conflicts++;
@@ -2993,6 +3090,9 @@ public:
     Solver * getSolver(){
         return S;
     }
+    const SolverConfig & getConfig() const {
+        return S->config;
+    }
 private:
 	vec<vec<int> > & getComparisonSet(Comparison op){
 		switch(op){
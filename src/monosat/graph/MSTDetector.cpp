@@ -35,14 +35,14 @@ MSTDetector<Weight,Graph>::MSTDetector(int detectorID, GraphTheorySolver<Weight>
 	positiveReachStatus = new MSTDetector<Weight,Graph>::MSTStatus(*this, true);
 	negativeReachStatus = new MSTDetector<Weight,Graph>::MSTStatus(*this, false);
 
-	if (mstalg == MinSpanAlg::ALG_KRUSKAL) {
+	if (outer->getConfig().mstalg == MinSpanAlg::ALG_KRUSKAL) {
 		underapprox_detector = new Kruskal<MSTDetector<Weight,Graph>::MSTStatus, Weight>(g,
 																				   *(positiveReachStatus), 1);
 		overapprox_detector = new Kruskal<MSTDetector<Weight,Graph>::MSTStatus, Weight>(antig,
 																				  *(negativeReachStatus), -1);
 		underapprox_conflict_detector = underapprox_detector;
 		overapprox_conflict_detector = overapprox_detector;
-	} else if (mstalg == MinSpanAlg::ALG_PRIM) {
+	} else if (outer->getConfig().mstalg == MinSpanAlg::ALG_PRIM) {
 		underapprox_detector = new Prim<MSTDetector<Weight,Graph>::MSTStatus, Weight>(g,  *(positiveReachStatus),
 																				1);
 		overapprox_detector = new Prim<MSTDetector<Weight,Graph>::MSTStatus, Weight>(antig,
@@ -52,7 +52,7 @@ MSTDetector<Weight,Graph>::MSTDetector(int detectorID, GraphTheorySolver<Weight>
 		overapprox_conflict_detector = new Kruskal<typename MinimumSpanningTree<Weight>::NullStatus, Weight>(antig,
 																											 MinimumSpanningTree<Weight>::nullStatus, -1);
 
-	} else if (mstalg == MinSpanAlg::ALG_SPIRA_PAN) {
+	} else if (outer->getConfig().mstalg == MinSpanAlg::ALG_SPIRA_PAN) {
 
 		underapprox_detector = new SpiraPan<MSTDetector<Weight,Graph>::MSTStatus, Weight>(g,
 																					*(positiveReachStatus), 1); //new SpiraPan<MSTDetector<Weight,Graph>::MSTStatus>(_g,*(positiveReachStatus),1);
@@ -300,7 +300,7 @@ void MSTDetector<Weight,Graph>::TarjanOLCA(int node, vec<Lit> & conflict) {
 template<typename Weight,typename Graph>
 void MSTDetector<Weight,Graph>::buildMinWeightTooLargeReason(Weight & weight, vec<Lit> & conflict) {
 
-	static int it = 0;
+	static thread_local int it = 0;
 	++it;
 
 	//drawFull( non_reach_detectors[detector]->getSource(),u);
@@ -560,7 +560,7 @@ void MSTDetector<Weight,Graph>::buildEdgeInTreeReason(int edgeid, vec<Lit> & con
 	Var vt = outer->getEdgeVar(edgeid);
 	assert(vt > 0);
 	//assert(outer->value(vt)==l_True);
-	static int it = 0;
+	static thread_local int it = 0;
 	if (++it == 3) {
 		int a = 1;
 		;
@@ -689,7 +689,7 @@ void MSTDetector<Weight,Graph>::preprocess() {
 }
 template<typename Weight,typename Graph>
 bool MSTDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	if (++it == 7) {
 		int a = 1;
 	}
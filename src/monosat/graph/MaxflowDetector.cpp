@@ -46,7 +46,7 @@ MaxflowDetector<Weight,Graph>::MaxflowDetector(int _detectorID, GraphTheorySolve
 
     bvTheory = outer->bvTheory;
 
-    MinCutAlg alg = mincutalg;
+    MinCutAlg alg = outer->getConfig().mincutalg;
     if(outer->hasBitVectorEdges()){
         if (alg!= MinCutAlg::ALG_EDKARP_ADJ && alg != MinCutAlg::ALG_KOHLI_TORR){
             printf("Note: falling back on kohli-torr for maxflow, because edge weights are bitvectors\n");
@@ -654,7 +654,7 @@ template<typename Weight,typename Graph>
 void MaxflowDetector<Weight,Graph>::buildMaxFlowTooLowReason(Weight maxflow, vec<Lit> & conflict, bool force_maxflow) {
     //Consider using the kernigan-lin partitioning heuristic to get a separating cut here, instead of maxflow?
 
-    static int it = 0;
+    static thread_local int it = 0;
     ++it;
     if (it == 3) {
         int a = 1;
@@ -947,7 +947,7 @@ bool MaxflowDetector<Weight,Graph>::propagate(vec<Lit> & conflict, bool backtrac
 template<typename Weight,typename Graph>
 void MaxflowDetector<Weight,Graph>::FlowOp::analyzeReason(bool compareOver,Comparison op, Weight  to,  vec<Lit> & conflict){
 //watch out - might need to backtrack the graph theory appropriately, here...
-    static int iter = 0;
+    static thread_local int iter = 0;
     if(++iter==46){
         int a=1;
     }
@@ -1251,7 +1251,7 @@ void MaxflowDetector<Weight,Graph>::collectChangedEdges() {
 
     //need to deal with changes to bv edge weights, also!
     for (int j = changed_edges.size() - 1; j >= 0; j--) {
-        static int iter = 0;
+        static thread_local int iter = 0;
         ++iter;
         int edgeid = changed_edges[j];
         if(opt_theory_internal_vsids){
@@ -1390,7 +1390,7 @@ void MaxflowDetector<Weight,Graph>::collectChangedEdges() {
 template<typename Weight,typename Graph>
 void MaxflowDetector<Weight,Graph>::dbg_decisions() {
 #ifdef DEBUG_GRAPH
-    static int iter = 0;
+    static thread_local int iter = 0;
 	++iter;
 	if (iter == 911) {
 		int a = 1;
@@ -1614,7 +1614,7 @@ bool MaxflowDetector<Weight,Graph>::detectorIsSatisfied(){
 
 template<typename Weight,typename Graph>
 void MaxflowDetector<Weight,Graph>::undecide(Lit l) {
-    static int iter = 0;
+    static thread_local int iter = 0;
     Detector::unassign(l);
     if(outer->isEdgeVar(var(l))){
         ++iter;
@@ -1644,7 +1644,7 @@ Lit MaxflowDetector<Weight,Graph>::decide(CRef &decision_reason) {
     if(n_satisfied_lits==flow_lits.size())
         return lit_Undef;
 
-    static int it = 0;
+    static thread_local int it = 0;
     if (++it == 51085) {
         int a = 1;
     }
@@ -1966,7 +1966,7 @@ Lit MaxflowDetector<Weight,Graph>::decide(CRef &decision_reason) {
                 assert(over_flow >= required_flow);
 
 #ifdef DEBUG_GRAPH
-                static vec<bool> dbg_expect;
+                static thread_local vec<bool> dbg_expect;
 				int dbg_count = 0;
 				dbg_expect.clear();
 				dbg_expect.growTo(g_under.edges());
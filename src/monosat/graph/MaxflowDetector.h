@@ -180,6 +180,19 @@ public:
 
 
 	bool propagate(vec<Lit> & conflict, bool backtrackOnly, Lit & conflictLit) override;
+	bool supportsConcurrentUpdate() override {
+		//propagate() logs to the graphs' output files, which must not be interleaved with other detectors' updates
+		return !g_under.outfile() && !g_over.outfile();
+	}
+	void updateApproximations() override {
+		if (flow_lits.size() == 0 || n_satisfied_lits == flow_lits.size())
+			return;
+		//propagate() computes these lazily, but in the common case needs both of them.
+		if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0))
+			underapprox_detector->maxFlow();
+		if (overapprox_detector && (!opt_detect_pure_theory_lits || unassigned_negatives > 0))
+			overapprox_detector->maxFlow();
+	}
 	void analyzeMaxFlowLEQ(Weight flow, vec<Lit> & conflict, bool force_maxflow=false);
 	void analyzeMaxFlowGEQ(Weight flow, vec<Lit> & conflict);
 	void buildMaxFlowTooHighReason(Weight flow, vec<Lit> & conflict);
@@ -215,7 +228,7 @@ public:
 	void printStats() override {
 		Detector::printStats();
 		printf("\tTotal Detector Propagation Time: %fs\n",stats_total_prop_time);
-		if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		if (outer->getConfig().mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
 			KohliTorr<Weight> * kt = (KohliTorr<Weight> *) overapprox_detector;
 			printf(
 					"\tInit Time %f, Decision flow calculations: %" PRId64 ", (redecide: %f s) flow_calc %f s, flow_discovery %f s, (%" PRId64 ") (maxflow %f,flow assignment %f),  inits: %" PRId64 ",re-inits %" PRId64 "\n",
@@ -52,7 +52,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 	underprop_marker = CRef_Undef;
 	overprop_marker = CRef_Undef;
 	forced_edge_marker = CRef_Undef;
-	if (reachalg == ReachAlg::ALG_SAT) {
+	if (outer->getConfig().reachalg == ReachAlg::ALG_SAT) {
 		//to print out the solution
 		//positive_reach_detector = new ReachDetector::CNFReachability(*this,false);
 		//negative_reach_detector = new ReachDetector::CNFReachability(*this,true);
@@ -78,7 +78,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 	 }*/
 	positiveReachStatus = new ReachDetector<Weight,Graph>::ReachStatus(*this, true);
 	negativeReachStatus = new ReachDetector<Weight,Graph>::ReachStatus(*this, false);
-	if (reachalg == ReachAlg::ALG_BFS) {
+	if (outer->getConfig().reachalg == ReachAlg::ALG_BFS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new BFSReachability<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																								  *(positiveReachStatus), 1);
@@ -94,7 +94,23 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		underapprox_path_detector = underapprox_detector;
 		overapprox_path_detector = overapprox_reach_detector;
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	} else if (reachalg == ReachAlg::ALG_DFS) {
+	} else if (outer->getConfig().reachalg == ReachAlg::ALG_BFS_MULTI) {
+		//reachability is computed for all sources at once, in a traversal shared with every other reach detector on
+		//these graphs; paths are only needed for learning and decisions, so they are found separately, on demand.
+		if (!opt_encode_reach_underapprox_as_sat) {
+			underapprox_detector = new MultiSourceReach<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(
+					outer->getMultiSourceReach(g_under), from, g_under, *(positiveReachStatus), 1);
+		} else {
+			underapprox_fast_detector = new MultiSourceReach<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(
+					outer->getMultiSourceReach(g_under), from, g_under, *(positiveReachStatus), 1);
+		}
+		overapprox_reach_detector = new MultiSourceReach<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(
+				outer->getMultiSourceReach(g_over), from, g_over, *(negativeReachStatus), -1);
+
+		underapprox_path_detector = new BFSReachability<Weight,Graph,Reach::NullStatus>(from, g_under, Reach::nullStatus, 1);
+		overapprox_path_detector = new BFSReachability<Weight,Graph,Reach::NullStatus>(from, g_over, Reach::nullStatus, -1);
+		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
+	} else if (outer->getConfig().reachalg == ReachAlg::ALG_DFS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new DFSReachability<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																								  *(positiveReachStatus), 1);
@@ -113,7 +129,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 
 		negative_distance_detector = new UnweightedBFS<Weight,Graph,Distance<int>::NullStatus>(from, g_over, Distance<int>::nullStatus, -1);
 		overapprox_path_detector = overapprox_reach_detector;
-	} else if (reachalg == ReachAlg::ALG_DISTANCE) {
+	} else if (outer->getConfig().reachalg == ReachAlg::ALG_DISTANCE) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedBFS<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																								*(positiveReachStatus), 1);
@@ -128,7 +144,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		underapprox_path_detector = underapprox_detector;
 		overapprox_path_detector = overapprox_reach_detector;
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	} else if (reachalg == ReachAlg::ALG_RAMAL_REPS) {
+	} else if (outer->getConfig().reachalg == ReachAlg::ALG_RAMAL_REPS) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedRamalReps<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																									  *(positiveReachStatus), 1, false);
@@ -157,7 +173,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		//underapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_under, Distance<int>::nullStatus, 1);
 		//overapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_over, Distance<int>::nullStatus, -1);
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	}else if (reachalg == ReachAlg::ALG_RAMAL_REPS_BATCHED) {
+	}else if (outer->getConfig().reachalg == ReachAlg::ALG_RAMAL_REPS_BATCHED) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedRamalRepsBatched<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																											 *(positiveReachStatus), 1, false);
@@ -186,7 +202,7 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		//underapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_under, Distance<int>::nullStatus, 1);
 		//overapprox_path_detector = new UnweightedBFS<Weight,Distance<int>::NullStatus>(from, g_over, Distance<int>::nullStatus, -1);
 		negative_distance_detector = (Distance<int> *) overapprox_path_detector;
-	}else if (reachalg == ReachAlg::ALG_RAMAL_REPS_BATCHED2) {
+	}else if (outer->getConfig().reachalg == ReachAlg::ALG_RAMAL_REPS_BATCHED2) {
 		if (!opt_encode_reach_underapprox_as_sat) {
 			underapprox_detector = new UnweightedRamalRepsBatchedUnified<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(from, g_under,
 																													*(positiveReachStatus), 1, false);
@@ -252,18 +268,18 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		underapprox_fast_detector = underapprox_detector;
 
 	if (opt_reach_detector_combined_maxflow) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints (enforcing this using tempalte specialization...).
 
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
 
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
 			if (opt_use_kt_for_conflicts) {
 				conflict_flow = new KohliTorr<Weight>(cutGraph,  source, 0,
 													   opt_kt_preserve_order);
@@ -274,7 +290,8 @@ ReachDetector<Weight,Graph>::ReachDetector(int _detectorID, GraphTheorySolver<We
 		}
 	}
 
-	if(opt_graph_cache_propagation){
+	//(the path cache requires paths from the underlying algorithm, which multi-source reachability does not track)
+	if(opt_graph_cache_propagation && outer->getConfig().reachalg != ReachAlg::ALG_BFS_MULTI){
 		if(underapprox_detector){
 			Reach* original_underapprox_detector = underapprox_detector;
 			underapprox_detector = new CachedReach<Weight,Graph,ReachDetector<Weight,Graph>::ReachStatus>(original_underapprox_detector, g_under,*(positiveReachStatus),1,opt_rnd_shortest_path,opt_rnd_shortest_edge,drand(rnd_seed));
@@ -594,7 +611,7 @@ public:
 			under_reach = r->underapprox_fast_detector;
 		}
 
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if(++iter==16){
 			int a=1;
 			/*for(int edgeID = 0;edgeID<g_over.nEdgeIDs();edgeID++){
@@ -901,7 +918,7 @@ public:
 		if (outer->value(reach_lit)==l_Undef){
 			return lit_Undef;//if the reach lit is unassigned, do not make any decisions here
 		}
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if(++iter==11){
 			int a=1;
 		}
@@ -1068,23 +1085,23 @@ void ReachDetector<Weight,Graph>::addLit(int from, int to, Var outer_reach_var)
 			for (int i = 0; i < g_under.nodes(); i++) {
 				if (reach_lits[i] != lit_Undef && !conflict_flows[i]) {
 					MaxFlow<Weight> * conflict_flow_t = nullptr;
-					if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+					if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
 						conflict_flow_t = new EdmondsKarpDynamic< Weight>(cutGraph,  source,
 																		   i);
-					} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+					} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
 
 						conflict_flow_t = new EdmondsKarpAdj< Weight>(cutGraph,  source, i);
 
-					} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+					} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ) {
 
 						conflict_flow_t = new Dinitz< Weight>(cutGraph,  source, i);
 
-					} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+					} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 						//link-cut tree currently only supports ints (enforcing this using tempalte specialization...).
 
 						conflict_flow_t = new Dinitz< Weight>(cutGraph,  source, i);
 
-					} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+					} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
 						if (opt_use_kt_for_conflicts) {
 							conflict_flow_t = new KohliTorr< Weight>(cutGraph,  source, i,
 																	  opt_kt_preserve_order);
@@ -1211,7 +1228,7 @@ void ReachDetector<Weight,Graph>::buildReachReason(int node, vec<Lit> & conflict
 }
 template<typename Weight,typename Graph>
 void ReachDetector<Weight,Graph>::buildNonReachReason(int node, vec<Lit> & conflict, bool force_maxflow) {
-	static int it = 0;
+	static thread_local int it = 0;
 	++it;
 	if (it == 4) {
 		int a = 1;
@@ -1468,7 +1485,7 @@ void ReachDetector<Weight,Graph>::buildNonReachReason(int node, vec<Lit> & confl
  */
 template<typename Weight,typename Graph>
 void ReachDetector<Weight,Graph>::buildForcedEdgeReason(int reach_node, int forced_edge_id, vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	++it;
 
 	assert(outer->value(outer->getEdgeVar(forced_edge_id))==l_True);
@@ -1636,7 +1653,7 @@ void ReachDetector<Weight,Graph>::buildReason(Lit p, vec<Lit> & reason, CRef mar
 }
 template<typename Weight,typename Graph>
 bool ReachDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 5) {
 		int a = 1;
 	}
@@ -318,6 +318,16 @@ public:
 	void attachSubHeuristic(Heuristic * h, int to);
 	void buildSATConstraints(bool onlyUnderApprox = false, int within_steps = -1);
 	bool propagate(vec<Lit> & conflict) override;
+	bool supportsConcurrentUpdate() override {
+		return true;
+	}
+	void updateApproximations() override {
+		//same conditions as in propagate(), which will then find both approximations already up to date
+		if (underapprox_detector && (!opt_detect_pure_theory_lits || unassigned_positives > 0))
+			underapprox_detector->update();
+		if (overapprox_reach_detector && (!opt_detect_pure_theory_lits || unassigned_negatives > 0))
+			overapprox_reach_detector->update();
+	}
 	void buildReachReason(int node, vec<Lit> & conflict);
 	void buildNonReachReason(int node, vec<Lit> & conflict, bool force_maxflow = false);
 	void buildForcedEdgeReason(int reach_node, int forced_edge_id, vec<Lit> & conflict);
@@ -326,7 +326,7 @@ void SteinerDetector<Weight,Graph>::buildReason(Lit p, vec<Lit> & reason, CRef m
 }
 template<typename Weight,typename Graph>
 bool SteinerDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
-	static int it = 0;
+	static thread_local int it = 0;
 	if (++it == 7) {
 		int a = 1;
 	}
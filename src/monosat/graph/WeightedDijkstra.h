@@ -202,7 +202,7 @@ public:
 	}
 
 	void update() {
-		static int iteration = 0;
+		static thread_local int iteration = 0;
 		int local_it = ++iteration;
 		if (local_it == 17513) {
 			int a = 1;
@@ -21,6 +21,7 @@
 
 #include "monosat/core/Config.h"
 #include "monosat/dgl/RamalReps.h"
+#include "monosat/dgl/AStar.h"
 #include "monosat/dgl/EdmondsKarp.h"
 #include "monosat/dgl/EdmondsKarpAdj.h"
 #include "monosat/dgl/KohliTorr.h"
@@ -78,7 +79,7 @@ WeightedDistanceDetector<Weight,Graph>::WeightedDistanceDetector(int _detectorID
 		overapprox_weighted_distance_detector = new Dijkstra<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(
 				from, _antig,  *negativeDistanceStatus, 0);
 		underapprox_weighted_path_detector = underapprox_weighted_distance_detector;
-	}else if (  distalg == DistAlg::ALG_RAMAL_REPS) {
+	}else if (  outer->getConfig().distalg == DistAlg::ALG_RAMAL_REPS) {
 
 		underapprox_weighted_distance_detector =
 				new RamalReps<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(from, _g,
@@ -87,6 +88,14 @@ WeightedDistanceDetector<Weight,Graph>::WeightedDistanceDetector(int _detectorID
 				new RamalReps<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(from, _antig,
 																								 *(negativeDistanceStatus), -2);
 		underapprox_weighted_path_detector =underapprox_weighted_distance_detector; //new Dijkstra<Weight>(from, _g);
+	} else if (outer->getConfig().distalg == DistAlg::ALG_ASTAR) {
+		//point-to-point searches towards each queried node, rather than full single-source searches
+		underapprox_weighted_distance_detector =
+				new AStar<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(from, _g,
+																							 *positiveDistanceStatus, 0);
+		overapprox_weighted_distance_detector = new AStar<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(
+				from, _antig,  *negativeDistanceStatus, 0);
+		underapprox_weighted_path_detector = underapprox_weighted_distance_detector;
 	} else {
 		underapprox_weighted_distance_detector =
 				new Dijkstra<Weight,Graph, typename WeightedDistanceDetector<Weight,Graph>::DistanceStatus>(from, _g,
@@ -97,17 +106,17 @@ WeightedDistanceDetector<Weight,Graph>::WeightedDistanceDetector(int _detectorID
 	}
 
 	if (opt_conflict_min_cut) {
-		if (mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
+		if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_DYN) {
 			conflict_flow = new EdmondsKarpDynamic<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_EDKARP_ADJ) {
 			conflict_flow = new EdmondsKarpAdj<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ) {
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
-		} else if (mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_DINITZ_LINKCUT) {
 			//link-cut tree currently only supports ints
 			conflict_flow = new Dinitz<Weight>(cutGraph,  source, 0);
 
-		} else if (mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
+		} else if (outer->getConfig().mincutalg == MinCutAlg::ALG_KOHLI_TORR) {
 			if (opt_use_kt_for_conflicts) {
 				conflict_flow = new KohliTorr<Weight>(cutGraph, source, 0,
 													   opt_kt_preserve_order);
@@ -193,7 +202,7 @@ void WeightedDistanceDetector<Weight,Graph>::printSolution(std::ostream& write_t
 template<typename Weight,typename Graph>
 void WeightedDistanceDetector<Weight,Graph>::DistanceOp::analyzeReason(bool compareOver,Comparison op, Weight  to,  vec<Lit> & conflict){
 //watch out - might need to backtrack the graph theory appropriately, here...
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if(++iter==46){
 		int a=1;
 	}
@@ -403,7 +412,7 @@ void WeightedDistanceDetector<Weight,Graph>::analyzeDistanceGTReason(int to, Wei
 
 template<typename Weight,typename Graph>
 void WeightedDistanceDetector<Weight,Graph>::buildDistanceGTReason(int to, Weight & min_distance, vec<Lit> & conflict, bool strictComparison) {
-	static int it = 0;
+	static thread_local int it = 0;
 	stats_distance_gt_reasons++;
 	stats_over_conflicts++;
 	++it;
@@ -547,7 +556,7 @@ void WeightedDistanceDetector<Weight,Graph>::preprocess() {
 template<typename Weight,typename Graph>
 bool WeightedDistanceDetector<Weight,Graph>::propagate(vec<Lit> & conflict) {
 
-	static int iter = 0;
+	static thread_local int iter = 0;
 	if (++iter == 29) { //18303
 		int a = 1;
 	}
@@ -287,6 +287,14 @@ public:
 			printf("\tWeighted Reasons (leq,gt): %" PRId64 ",%" PRId64 "\n", stats_distance_leq_reasons, stats_distance_gt_reasons);
 			printf("\tConflict Edges Skipped (unweighted %" PRId64 ", weighted %" PRId64 ")\n", stats_gt_unweighted_edges_skipped,
 				   stats_gt_weighted_edges_skipped);
+			if (underapprox_weighted_distance_detector) {
+				printf("\t\tUnderapproxDistance: ");
+				underapprox_weighted_distance_detector->printStats();
+			}
+			if (overapprox_weighted_distance_detector) {
+				printf("\t\tOverapproxDistance: ");
+				overapprox_weighted_distance_detector->printStats();
+			}
 		}
 	}
 
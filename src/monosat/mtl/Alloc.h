@@ -62,6 +62,10 @@ public:
 	uint32_t wasted() const {
 		return wasted_;
 	}
+	// Bytes currently reserved by the region (including wasted and unused space).
+	uint64_t bytesReserved() const {
+		return (uint64_t) cap * sizeof(T);
+	}
 	
 	Ref alloc(int size);
 	void free(int size) {
@@ -80,8 +80,8 @@ bool opt_satlive = true;
 bool opt_ansi = true;
 
 void reportf(const char *format, ...) {
-    static bool col0 = true;
-    static bool bold = false;
+    static thread_local bool col0 = true;
+    static thread_local bool bold = false;
     va_list args;
     va_start(args, format);
     char *text = vnsprintf(format, args);
@@ -86,6 +86,7 @@ public:
 
     friend char* toString(Int num) { char buf[32]; sprintf(buf, "%lld", num.data); return xstrdup(buf); }   // Caller must free string.
     friend int   toint   (Int num) { if (num > INT_MAX || num < INT_MIN) throw Exception_IntOverflow(xstrdup("toint")); return (int)num.data; }
+    friend int64 toint64 (Int num) { return num.data; }
 };
 
 
@@ -327,6 +328,12 @@ public:
         return (int) mpz_get_si(*num.data);
     }
 
+    friend int64 toint64(Int num) {
+        if (num.small() || !mpz_fits_slong_p(*num.data) || sizeof(long) < sizeof(int64))
+            throw Exception_IntOverflow(xstrdup("toint64"));
+        return (int64) mpz_get_si(*num.data);
+    }
+
     uint hash() const {   // primitive hash function -- not good with bit-shifts
         mp_size_t size = mpz_size(*data);
         mp_limb_t val = 0;
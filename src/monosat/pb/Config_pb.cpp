@@ -8,6 +8,7 @@ Monosat::BoolOption  Monosat::PB::opt_try(_cat_pb,"pb-try","(hidden option -- if
 Monosat::IntOption Monosat::PB::opt_verbosity(_cat_pb, "pb-verb",
                                     "", 0, IntRange(0, 3));
 Monosat::BoolOption Monosat::PB::opt_preprocess(_cat_pb,"pb-pre","",true);
+Monosat::IntOption Monosat::PB::opt_native_threshold(_cat_pb,"pb-native","Propagate PB constraints natively, instead of converting them to clauses, if their estimated adder encoding cost is larger than this (-1 to always convert)",64,IntRange(-1,INT32_MAX));
 Monosat::BoolOption Monosat::PB::opt_convert_weak(_cat_pb,"pb-convert-weak","",true);
 Monosat::DoubleOption Monosat::PB::opt_bdd_thres(_cat_pb,"pb-bdd-threshold","",3,DoubleRange(0, false, HUGE_VAL, false));
 Monosat::DoubleOption Monosat::PB::opt_sort_thres(_cat_pb,"pb-sort-threshold","",20,DoubleRange(0, false, HUGE_VAL, false));
@@ -41,6 +41,7 @@ extern Command opt_command;
 extern BoolOption opt_branch_pbvars;
 extern IntOption opt_polarity_sug;
 extern BoolOption opt_preprocess;
+extern IntOption opt_native_threshold;
 }
 }
 #endif //MONOSAT_CONFIG_PB_H
@@ -0,0 +1,307 @@
+/**************************************************************************************************
+ The MIT License (MIT)
+
+ Copyright (c) 2018, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef MONOSAT_PBNATIVETHEORY_H
+#define MONOSAT_PBNATIVETHEORY_H
+
+#include "monosat/mtl/Vec.h"
+#include "monosat/mtl/Sort.h"
+#include "monosat/core/SolverTypes.h"
+#include "monosat/core/Theory.h"
+#include "monosat/core/Solver.h"
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+namespace Monosat {
+namespace PB {
+
+//Native propagator for pseudo-boolean constraints of the form sum(coef_i * lit_i) >= bound, with positive coefficients.
+//PbSolver hands constraints to this theory instead of converting them to CNF when their encoding would be too large
+//(see -pb-native).
+//
+//Each constraint tracks its slack: the sum of the coefficients of its non-false literals, minus the bound.
+//A literal becoming false reduces the slack of each constraint it occurs in by its coefficient; a negative slack is a
+//conflict, and any unassigned literal with a coefficient larger than the slack must be true.
+//Literals are stored sorted by decreasing coefficient, so a constraint whose slack is at least its largest coefficient
+//is never visited by propagation, and otherwise the propagation scan stops at the first coefficient within the slack.
+//Conflict and reason clauses are built from the false literals with the largest coefficients, keeping only as many
+//as are needed to exceed the slack (the clausal weakening of the constraint that is implied by the assignment).
+class PbNativeTheory: public Theory {
+    Solver *S;
+    int theory_index = -1;
+    CRef propagation_reason;
+
+    struct Term {
+        Lit lit;
+        int64_t coef;
+    };
+    struct Constraint {
+        vec<Term> terms; //sorted by decreasing coefficient
+        int64_t bound = 0;
+        int64_t max_slack = 0; //sum of coefficients, minus bound
+        int64_t slack = 0; //sum of coefficients of non-false literals, minus bound
+        bool in_queue = false;
+    };
+    struct Watch {
+        int constraintID;
+        int64_t coef;
+    };
+    struct TermGt {
+        bool operator()(const Term &a, const Term &b) const {
+            return a.coef > b.coef;
+        }
+    };
+
+    vec<Constraint> constraints;
+    vec<vec<Watch>> watches; //for each literal, the constraints whose slack is reduced when that literal is assigned true
+    vec<int> queue;
+
+    //for each variable, the literal assigned to it (as seen by this theory), and the order in which it was assigned
+    vec<Lit> assigned;
+    vec<int64_t> assigned_pos;
+    int64_t next_pos = 0;
+    vec<int> reason_constraint;
+    vec<bool> registered;
+
+public:
+    int64_t stats_propagations = 0;
+    int64_t stats_lit_propagations = 0;
+    int64_t stats_conflicts = 0;
+    int64_t stats_reasons = 0;
+    int64_t stats_skipped_constraints = 0;
+
+    PbNativeTheory(Solver *S) : S(S) {
+        S->addTheory(this);
+        propagation_reason = S->newReasonMarker(this);
+    }
+
+    ~PbNativeTheory() override {
+    }
+
+    const char *getTheoryType() override {
+        return "PB";
+    }
+
+    int nConstraints() const {
+        return constraints.size();
+    }
+
+    //Add the constraint sum(coefs[i]*lits[i]) >= bound, where all coefficients are positive and each variable occurs at
+    //most once. Returns false if the constraint is unsatisfiable at level 0.
+    bool addConstraint(const vec<Lit> &lits, const vec<int64_t> &coefs, int64_t bound) {
+        S->cancelUntil(0);
+        int constraintID = constraints.size();
+        constraints.push();
+        Constraint &c = constraints.last();
+        int64_t sum = 0;
+        for (int i = 0; i < lits.size(); i++) {
+            assert(coefs[i] > 0);
+            Lit l = lits[i];
+            if (S->value(l) == l_True) {
+                bound -= coefs[i];
+            } else if (S->value(l) == l_Undef) {
+                c.terms.push({l, coefs[i]});
+                sum += coefs[i];
+            }
+        }
+        if (bound <= 0) {
+            //trivially satisfied
+            constraints.pop();
+            return true;
+        }
+        if (sum < bound) {
+            constraints.pop();
+            return S->addEmptyClause();
+        }
+        sort(c.terms, TermGt());
+        c.bound = bound;
+        c.max_slack = sum - bound;
+        c.slack = c.max_slack;
+        for (Term &t:c.terms) {
+            Var v = var(t.lit);
+            registered.growTo(v + 1, false);
+            assigned.growTo(v + 1, lit_Undef);
+            assigned_pos.growTo(v + 1, -1);
+            reason_constraint.growTo(v + 1, -1);
+            if (!registered[v]) {
+                registered[v] = true;
+                S->newTheoryVar(v, getTheoryIndex(), v); //using the same variable indices in the theory as out of it
+            }
+            watches.growTo(2 * (v + 1));
+            watches[toInt(~t.lit)].push({constraintID, t.coef});
+        }
+        enqueueConstraint(constraintID);
+        S->needsPropagation(getTheoryIndex());
+        return true;
+    }
+
+    inline int getTheoryIndex() const override {
+        return theory_index;
+    }
+
+    inline void setTheoryIndex(int id) override {
+        theory_index = id;
+    }
+
+    inline void newDecisionLevel() override {
+    }
+
+    inline void backtrackUntil(int untilLevel) override {
+    }
+
+    void enqueueTheory(Lit l) override {
+        Var v = var(l);
+        if (assigned[v] != lit_Undef)
+            return;
+        assigned[v] = l;
+        assigned_pos[v] = next_pos++;
+        for (Watch &w:watches[toInt(l)]) {
+            Constraint &c = constraints[w.constraintID];
+            c.slack -= w.coef;
+            if (c.slack < c.terms[0].coef) {
+                enqueueConstraint(w.constraintID);
+            }
+        }
+    }
+
+    void undecideTheory(Lit l) override {
+        Var v = var(l);
+        Lit a = assigned[v];
+        if (a == lit_Undef)
+            return;
+        assigned[v] = lit_Undef;
+        for (Watch &w:watches[toInt(a)]) {
+            constraints[w.constraintID].slack += w.coef;
+        }
+    }
+
+    bool propagateTheory(vec<Lit> &conflict) override {
+        S->theoryPropagated(this);
+        stats_propagations++;
+        while (queue.size()) {
+            int constraintID = queue.last();
+            queue.pop();
+            Constraint &c = constraints[constraintID];
+            c.in_queue = false;
+            if (c.slack < 0) {
+                stats_conflicts++;
+                conflict.clear();
+                int64_t falsified = 0;
+                for (Term &t:c.terms) {
+                    if (falsified > c.max_slack)
+                        break;
+                    if (assigned[var(t.lit)] == ~t.lit) {
+                        conflict.push(t.lit);
+                        falsified += t.coef;
+                    }
+                }
+                assert(falsified > c.max_slack);
+                //leave the constraint queued; its slack will be restored when the solver backtracks
+                enqueueConstraint(constraintID);
+                return false;
+            }
+            if (c.slack >= c.terms[0].coef) {
+                stats_skipped_constraints++;
+                continue;
+            }
+            for (Term &t:c.terms) {
+                if (t.coef <= c.slack)
+                    break;
+                if (S->value(t.lit) == l_Undef) {
+                    stats_lit_propagations++;
+                    reason_constraint[var(t.lit)] = constraintID;
+                    S->enqueue(t.lit, propagation_reason);
+                }
+            }
+        }
+        return true;
+    }
+
+    inline bool solveTheory(vec<Lit> &conflict) override {
+        return propagateTheory(conflict);
+    }
+
+    void buildReason(Lit p, vec<Lit> &reason, CRef reason_marker) override {
+        stats_reasons++;
+        assert(reason_marker == propagation_reason);
+        assert(S->value(p) == l_True);
+        Var v = var(p);
+        Constraint &c = constraints[reason_constraint[v]];
+        int64_t coef = 0;
+        for (Term &t:c.terms) {
+            if (t.lit == p) {
+                coef = t.coef;
+                break;
+            }
+        }
+        assert(coef > 0);
+        //p is implied once the literals that were false before it was assigned reduce the slack below its coefficient
+        int64_t required = c.max_slack - coef;
+        int64_t falsified = 0;
+        reason.push(p);
+        for (Term &t:c.terms) {
+            if (falsified > required)
+                break;
+            Var u = var(t.lit);
+            if (assigned[u] == ~t.lit && assigned_pos[u] < assigned_pos[v]) {
+                reason.push(t.lit);
+                falsified += t.coef;
+            }
+        }
+        assert(falsified > required);
+    }
+
+    bool check_solved() override {
+        for (Constraint &c:constraints) {
+            int64_t sum = 0;
+            for (Term &t:c.terms) {
+                if (S->value(t.lit) == l_True)
+                    sum += t.coef;
+            }
+            if (sum < c.bound)
+                return false;
+        }
+        return true;
+    }
+
+    void printStats(int detailLevel) override {
+        printf("PB Theory %d stats:\n", getTheoryIndex());
+        printf("Constraints: %d\n", constraints.size());
+        printf("Propagations: %" PRId64 " (%" PRId64 " lits, %" PRId64 " constraints skipped)\n", stats_propagations,
+               stats_lit_propagations, stats_skipped_constraints);
+        printf("Conflicts: %" PRId64 "\n", stats_conflicts);
+        printf("Reasons: %" PRId64 "\n", stats_reasons);
+        fflush(stdout);
+    }
+
+private:
+    void enqueueConstraint(int constraintID) {
+        if (!constraints[constraintID].in_queue) {
+            constraints[constraintID].in_queue = true;
+            queue.push(constraintID);
+        }
+    }
+};
+
+}
+}
+#endif //MONOSAT_PBNATIVETHEORY_H
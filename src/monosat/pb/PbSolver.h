@@ -84,9 +84,12 @@ public:
 // PbSolver -- Pseudo-boolean solver (linear boolean constraints):
 
 
+class PbNativeTheory;
+
 class PbSolver : public PBConstraintSolver {
 protected:
     SimpSolver & sat_solver;     // Underlying SAT solver.
+    PbNativeTheory *native_theory = nullptr; // Propagates constraints too large to encode (see -pb-native); owned by 'sat_solver'.
     vec<Var> vars;
     vec<int> var_indices;
     vec<Lit> trail;          // Chronological assignment stack.
@@ -124,6 +127,7 @@ protected:
     bool rewriteAlmostClauses();
 
     bool convertPbs(bool first_call);   // Called from 'solve()' to convert PB constraints to clauses.
+    bool addNative(const Linear &c);    // Called from 'convertPbs()' for constraints that are too large to convert.
     /*int getIndex(Var v){
         assert(v>=0);
         assert(v<var_indices.size());
@@ -19,6 +19,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "PbSolver.h"
 #include "Hardware.h"
+#include "PbNativeTheory.h"
+#include <mutex>
 namespace Monosat {
 namespace PB {
 //-------------------------------------------------------------------------------------------------
@@ -28,7 +30,48 @@ Formula convertToBdd(const Linear &c, int max_cost = INT_MAX);   // From: PbSolv
 //-------------------------------------------------------------------------------------------------
 
 
+//The formula environment (FEnv) is shared by all PB solvers in the process, and each solver's clausify context caches
+//formula indices from it across calls; so conversions from solvers on different threads must take turns.
+static std::mutex convert_mutex;
+
+//Hand the constraint to the native PB theory, instead of converting it to clauses.
+//Returns false (leaving the constraint to be converted) if its coefficients are too large for 64-bit slack counters.
+bool PbSolver::addNative(const Linear &c) {
+    const Int max_sum = Int(1 << 30) * Int(1 << 30);
+    Int sum = 0;
+    for (int i = 0; i < c.size; i++) {
+        if (c(i) > max_sum)
+            return false;
+        sum += c(i);
+        if (sum > max_sum)
+            return false;
+    }
+    if ((c.lo != Int_MIN && (c.lo > max_sum || c.lo < -max_sum)) || (c.hi != Int_MAX && (c.hi > max_sum || c.hi < -max_sum)))
+        return false;
+
+    if (!native_theory)
+        native_theory = new PbNativeTheory(&sat_solver);
+    vec<Lit> lits;
+    vec<int64_t> coefs;
+    for (int i = 0; i < c.size; i++) {
+        lits.push(toSolver(c[i]));
+        coefs.push(toint64(c(i)));
+    }
+    if (c.lo != Int_MIN && !native_theory->addConstraint(lits, coefs, toint64(c.lo)))
+        return true;
+    if (c.hi != Int_MAX) {
+        //sum(coefs[i]*lits[i]) <= hi  <=>  sum(coefs[i]*~lits[i]) >= sum(coefs) - hi
+        for (int i = 0; i < lits.size(); i++)
+            lits[i] = ~lits[i];
+        native_theory->addConstraint(lits, coefs, toint64(sum - c.hi));
+    }
+    if (opt_verbosity >= 1)
+        reportf("Native: %d lits\n", c.size);
+    return true;
+}
+
 bool PbSolver::convertPbs(bool first_call) {
+    std::lock_guard<std::mutex> lock(convert_mutex);
     vec<Formula> converted_constrs;
 
     if (first_call) {
@@ -47,6 +90,11 @@ bool PbSolver::convertPbs(bool first_call) {
         if (opt_verbosity >= 1)
             /**/reportf("---[%4d]---> ", constrs.size() - 1 - i);
 
+        if (opt_native_threshold >= 0 && estimatedAdderCost(c) > opt_native_threshold && addNative(c)) {
+            if (!okay()) return false;
+            continue;
+        }
+
         if (opt_convert == ct_Sorters)
             converted_constrs.push(buildConstraint(c));
         else if (opt_convert == ct_Adders)
@@ -321,7 +321,7 @@ public:
 
 		stats_propagations++;
 
-		static int iter = 0;
+		static thread_local int iter = 0;
 		++iter;
 		double startproptime = rtime(2);
 
@@ -392,7 +392,7 @@ public:
 			} else if (rhs_val == l_True && overApprox < total) {
 				//conflict
 				assert(pbclause.side != ConstraintSide::Lower);
-				static int iter = 0;
+				static thread_local int iter = 0;
 				++iter;
 				conflict.push(~rhs);
 				buildSumLTReason(clauseID, conflict);
@@ -1296,7 +1296,7 @@ public:
 		stats_reasons++;
 
 		int clauseID = reasonMap[marker];
-		static int iter = 0;
+		static thread_local int iter = 0;
 		if (++iter == 13) {
 			int a = 1;
 		}
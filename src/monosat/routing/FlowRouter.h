@@ -201,7 +201,7 @@ public:
             auto * over_reach =reach;
             auto * over_path = reach;
 
-            static int iter = 0;
+            static thread_local int iter = 0;
             if(++iter==109){
                 int a=1;
             };
@@ -450,7 +450,7 @@ public:
                         assert(false);
                         return lit_Undef;//if the reach lit is unassigned, do not make any decisions here
                     }
-                    static int iter = 0;
+                    static thread_local int iter = 0;
                     if(++iter==11){
                         int a=1;
                     }
@@ -781,7 +781,7 @@ template<typename Weight>
 bool FlowRouter<Weight>::propagateTheory(vec<Lit> &conflict, bool solve) {
     //for each net to be routed, pick one unrouted endpoint (if any).
     //connect it to destination in g.
-    static int iter = 0;
+    static thread_local int iter = 0;
     ++iter;
 
     if(!maxflow_detector->propagate(conflict)){
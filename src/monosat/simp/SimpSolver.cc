@@ -367,8 +367,8 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose) {
 
 	while (subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) {
 
-		// Empty subsumption queue and return immediately on user-interrupt:
-		if (asynch_interrupt) {
+		// Empty subsumption queue and return immediately on user-interrupt (or when a resource limit is reached):
+		if (limitReached()) {
 			subsumption_queue.clear();
 			bwdsub_assigns = trail.size();
 			break;
@@ -656,8 +656,8 @@ bool SimpSolver::eliminate(bool turn_off_elim) {
 			goto cleanup;
 		}
 
-		// Empty elim_heap and return immediately on user-interrupt:
-		if (asynch_interrupt) {
+		// Empty elim_heap and return immediately on user-interrupt (or when a resource limit is reached):
+		if (limitReached()) {
 			assert(bwdsub_assigns == trail.size());
 			assert(subsumption_queue.size() == 0);
 			assert(n_touched == 0);
@@ -669,7 +669,7 @@ bool SimpSolver::eliminate(bool turn_off_elim) {
 		for (int cnt = 0; !elim_heap.empty(); cnt++) {
 			Var elim = elim_heap.removeMin();
 
-			if (asynch_interrupt)
+			if (limitReached())
 				break;
 
 			if (isEliminated(elim) || value(elim) != l_Undef)
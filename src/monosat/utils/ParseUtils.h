@@ -29,6 +29,15 @@
 #include "monosat/mtl/Vec.h"
 #include <stdexcept>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#if !defined(_WIN32)
+#define MONOSAT_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 namespace Monosat {
 
 //-------------------------------------------------------------------------------------------------
@@ -55,25 +64,98 @@ class StreamBuffer {
 	//unsigned char buf[buffer_size];
 	vec<unsigned char> buf;//storing the buffer in a vector, to ensure it is heap allocated instead of stack allocated,
 	//to avoid overflowing the default JVM stack size (which is very small on some platforms).
-	int pos;
-	int size;
+	//Either points into buf, or (if the input is memory mapped) to the entire file
+	const unsigned char * data;
+	int64_t pos;
+	int64_t size;
+	bool owns_in = false;
+	void * mapping = nullptr;
+	size_t mapping_size = 0;
 
 	void assureLookahead() {
-		if (pos >= size) {
+		if (pos >= size && in) {
 			pos = 0;
 			size = gzread(in, &buf[0], buf.size());
 		}
 	}
-	
+
+	//Returns true if 'filename' was successfully memory mapped.
+	//Gzipped inputs (as well as anything that isn't a regular file, such as a pipe) are left for zlib to read.
+	bool mapFile(const char * filename) {
+#ifdef MONOSAT_HAS_MMAP
+		int fd = ::open(filename, O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		unsigned char magic[2] = { 0, 0 };
+		if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0 || pread(fd, magic, 2, 0) < 0
+				|| (magic[0] == 0x1f && magic[1] == 0x8b)) {
+			::close(fd);
+			return false;
+		}
+		void * m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);//the mapping remains valid after the file is closed
+		if (m == MAP_FAILED)
+			return false;
+		madvise(m, st.st_size, MADV_SEQUENTIAL);
+		mapping = m;
+		mapping_size = st.st_size;
+		data = (const unsigned char*) m;
+		size = st.st_size;
+		return true;
+#else
+		return false;
+#endif
+	}
+
 public:
 	explicit StreamBuffer(gzFile i) :
 			in(i), pos(0), size(0) {
 		buf.growTo(buffer_size);
+		data = &buf[0];
 		assureLookahead();
 	}
-	
+
+	/**
+	 * Open 'filename' for reading. If allow_mmap is set and the file is an uncompressed regular file,
+	 * then it is memory mapped and parsed in place; otherwise it is read (and decompressed, if necessary) through zlib.
+	 * Check isOpen() to determine whether the file could be opened.
+	 */
+	explicit StreamBuffer(const char * filename, bool allow_mmap = true) :
+			in(nullptr), data(nullptr), pos(0), size(0) {
+		if (allow_mmap && mapFile(filename))
+			return;
+		in = gzopen(filename, "rb");
+		if (in) {
+			owns_in = true;
+			buf.growTo(buffer_size);
+			data = &buf[0];
+			assureLookahead();
+		}
+	}
+
+	~StreamBuffer() {
+#ifdef MONOSAT_HAS_MMAP
+		if (mapping)
+			munmap(mapping, mapping_size);
+#endif
+		if (owns_in)
+			gzclose(in);
+	}
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	bool isOpen() const {
+		return in || mapping;
+	}
+
+	bool isMapped() const {
+		return mapping != nullptr;
+	}
+
 	int operator *() const {
-		return (pos >= size) ? EOF : buf[pos];
+		return (pos >= size) ? EOF : data[pos];
 	}
 	void operator ++() {
 		pos++;
@@ -84,9 +166,23 @@ public:
 		for(int i = 0;i<n;i++)
 			this->operator ++();
 	}
-	int position() const {
+	int64_t position() const {
 		return pos;
 	}
+
+	//Direct access to the bytes that are already buffered (or mapped), starting at the current position.
+	const unsigned char * current() const {
+		return data + pos;
+	}
+	int64_t available() const {
+		return size - pos;
+	}
+	//Skip n <= available() buffered bytes.
+	void advance(int64_t n) {
+		assert(n >= 0 && n <= available());
+		pos += n;
+		assureLookahead();
+	}
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -133,6 +229,29 @@ static void skipLine(B& in) {
 	}
 }
 
+//Copy the remainder of the current line (including the trailing newline, if any) into 'linebuf', followed by a terminating 0.
+//Returns false if the end of file is reached before a newline.
+template<class B>
+static bool readLine(B& in, vec<char> & linebuf) {
+	linebuf.clear();
+	for (;;) {
+		if (isEof(in)) {
+			linebuf.push(0);
+			return false;
+		}
+		else if (*in == '\n') {
+			linebuf.push(*in);
+			++in;
+			break;
+		} else {
+			linebuf.push(*in);
+			++in;
+		}
+	}
+	linebuf.push(0);
+	return true;
+}
+
 template<class B>
 static int parseInt(B& in) {
 	int val = 0;
@@ -164,6 +283,118 @@ static int64_t parseLong(B& in) {
 	return neg ? -val : val;
 }
 
+//-------------------------------------------------------------------------------------------------
+// Faster versions of the above for StreamBuffer, which operate directly on the buffered bytes.
+
+//Parse up to 8 leading decimal digits from p (which must have at least 8 readable bytes) at once,
+//storing their value in 'val'. Returns the number of digits parsed.
+static inline int parseDigits8(const unsigned char * p, uint64_t & val) {
+	uint64_t chunk;
+	memcpy(&chunk, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && defined(__GNUC__)
+	//set the high bit of each byte that is not in '0'..'9'
+	uint64_t lo = chunk & 0x7F7F7F7F7F7F7F7FULL;
+	uint64_t above9 = lo + 0x4646464646464646ULL;
+	uint64_t atleast0 = (lo | 0x8080808080808080ULL) - 0x3030303030303030ULL;
+	uint64_t nondigit = (above9 | ~atleast0 | chunk) & 0x8080808080808080ULL;
+	int n = nondigit ? (__builtin_ctzll(nondigit) >> 3) : 8;
+	if (n == 0)
+		return 0;
+	//right-align the n digits (so that leading bytes are zero), then combine pairs of digits, then pairs of pairs, and so on.
+	uint64_t digits = (chunk - 0x3030303030303030ULL) << (8 * (8 - n));
+	digits = (digits * 10 + (digits >> 8)) & 0x00FF00FF00FF00FFULL;
+	digits = (digits * 100 + (digits >> 16)) & 0x0000FFFF0000FFFFULL;
+	digits = (digits * 10000 + (digits >> 32)) & 0x00000000FFFFFFFFULL;
+	val = digits;
+	return n;
+#else
+	int n = 0;
+	val = 0;
+	while (n < 8 && p[n] >= '0' && p[n] <= '9')
+		val = val * 10 + (p[n++] - '0');
+	return n;
+#endif
+}
+
+static inline int64_t parseDigits(StreamBuffer & in) {
+	static const int64_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+	int64_t val = 0;
+	while (in.available() >= 8) {
+		uint64_t digits;
+		int n = parseDigits8(in.current(), digits);
+		val = val * pow10[n] + digits;
+		in.advance(n);
+		if (n < 8)
+			return val;
+	}
+	while (*in >= '0' && *in <= '9')
+		val = val * 10 + (*in - '0'), ++in;
+	return val;
+}
+
+static inline int64_t parseLong(StreamBuffer & in) {
+	bool neg = false;
+	skipWhitespace(in);
+	if (*in == '-')
+		neg = true, ++in;
+	else if (*in == '+')
+		++in;
+	if (*in < '0' || *in > '9')
+		parse_errorf("PARSE ERROR! Unexpected char while parsing long: %c\n", *in);
+	int64_t val = parseDigits(in);
+	return neg ? -val : val;
+}
+
+static inline int parseInt(StreamBuffer & in) {
+	bool neg = false;
+	skipWhitespace(in);
+	if (*in == '-')
+		neg = true, ++in;
+	else if (*in == '+')
+		++in;
+	if (*in < '0' || *in > '9')
+		parse_errorf("PARSE ERROR! Unexpected char while parsing int: %c\n", *in);
+	int val = (int) parseDigits(in);
+	return neg ? -val : val;
+}
+
+static inline bool readLine(StreamBuffer & in, vec<char> & linebuf) {
+	linebuf.clear();
+	for (;;) {
+		int64_t n = in.available();
+		if (n <= 0) {
+			linebuf.push(0);
+			return false;
+		}
+		const unsigned char * p = in.current();
+		const unsigned char * nl = (const unsigned char*) memchr(p, '\n', n);
+		int64_t len = nl ? (nl - p + 1) : n;
+		int start = linebuf.size();
+		linebuf.growTo(start + len);
+		memcpy(&linebuf[start], p, len);
+		in.advance(len);
+		if (nl)
+			break;
+	}
+	linebuf.push(0);
+	return true;
+}
+
+static inline void skipLine(StreamBuffer & in) {
+	for (;;) {
+		int64_t n = in.available();
+		if (n <= 0)
+			return;
+		const unsigned char * p = in.current();
+		const void * nl = memchr(p, '\n', n);
+		if (nl) {
+			in.advance((const unsigned char*) nl - p + 1);
+			return;
+		}
+		in.advance(n);
+	}
+}
+
 template<class B>
 static double parseDouble(B& in, vec<char> & tmp) {
 	int val = 0;
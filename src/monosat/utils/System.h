@@ -21,6 +21,7 @@
 #ifndef Minisat_System_h
 #define Minisat_System_h
 #include <cstdint>
+#include <chrono>
 #if defined(__linux__)
 #include <fpu_control.h>
 #endif
@@ -32,6 +33,7 @@
 namespace Monosat {
 static inline double fastTime(void); // CPU-time in seconds (fast, possibly less accurate).
 static inline double cpuTime(void); // CPU-time in seconds.
+static inline double monotonicTime(void); // Wall-clock seconds from a monotonic clock (unaffected by changes to the system clock).
 extern double memUsed();            // Memory in mega bytes (returns 0 for unsupported architectures).
 extern double memUsedPeak();        // Peak-memory in mega bytes (returns 0 for unsupported architectures).
 
@@ -40,6 +42,10 @@ extern double memUsedPeak();        // Peak-memory in mega bytes (returns 0 for
 //-------------------------------------------------------------------------------------------------
 // Implementation of inline functions:
 
+static inline double Monosat::monotonicTime(void) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 #if defined(_MSC_VER) || defined(__MINGW32__) || defined(__APPLE__)
 #include <time.h>
 